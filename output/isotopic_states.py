@@ -0,0 +1,78 @@
+# isotopic_states.py
+import sqlite3
+import struct
+import zlib
+
+###############################################################################
+###############################################################################
+
+def decodeComposition(blob, compressed = False) :
+    """
+    Decodes a Composition blob from the IsotopicStates table, as written by
+    RecipeLibrary::encodeComposition, into a list of (IsoID, Value) pairs in
+    ascending isotope order. The blob holds the number of isotopes as a
+    uint32, the isotope IDs as int32s, and their values as float64s, all
+    little endian, and is deflated by zlib if it was compressed.
+    """
+    data = bytes(blob)
+    if compressed :
+        data = zlib.decompress(data)
+    if len(data) < 4 :
+        raise ValueError("A composition blob is missing its size.")
+    n = struct.unpack('<I', data[:4])[0]
+    if len(data) != 4 + 12 * n :
+        raise ValueError("A composition blob has the wrong size.")
+    isos = struct.unpack('<%di' % n, data[4:4 + 4 * n])
+    values = struct.unpack('<%dd' % n, data[4 + 4 * n:])
+    return list(zip(isos, values))
+
+###############################################################################
+
+def hasBlobLayout(conn) :
+    """
+    Returns True if the IsotopicStates table of a cyclus output database holds
+    a blob per composition, as written with --blob-output, rather than a row
+    per isotope.
+    """
+    c = conn.cursor()
+    cols = [col[1] for col in c.execute("PRAGMA table_info(IsotopicStates)")]
+    return 'Composition' in cols
+
+###############################################################################
+
+def readIsotopicStates(conn) :
+    """
+    Returns a dictionary of each state ID in the IsotopicStates table of a
+    cyclus output database to a dictionary of its isotopes and their values.
+    Either layout of the table is read, a row per isotope or a blob per
+    composition. States written compactly as differences from a parent state
+    (listed in the IsotopicStateParents table) are expanded, and the isotopes
+    they remove from their parents are dropped.
+    """
+    c = conn.cursor()
+
+    states = {}
+    if hasBlobLayout(conn) :
+        rows = c.execute("SELECT ID, Compressed, Composition " + \
+                         "FROM IsotopicStates")
+        for id, compressed, blob in rows :
+            states[id] = dict(decodeComposition(blob, compressed))
+    else :
+        for id, iso, value in c.execute("SELECT ID, IsoID, Value " + \
+                                        "FROM IsotopicStates") :
+            states.setdefault(id, {})[iso] = value
+
+    tables = [t[0] for t in c.execute("SELECT name FROM sqlite_master " + \
+                                      "WHERE type = 'table'")]
+    if 'IsotopicStateParents' not in tables :
+        return states
+
+    # parents are always written before their children
+    parents = c.execute("SELECT ID, ParentID FROM IsotopicStateParents " + \
+                        "ORDER BY ID").fetchall()
+    for id, parent in parents :
+        state = dict(states[parent])
+        state.update(states.get(id, {}))
+        states[id] = dict((iso, value) for iso, value in state.items() \
+                          if value != 0)
+    return states
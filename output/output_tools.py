@@ -2,6 +2,7 @@
 import sqlite3
 from numpy import zeros
 from numpy import cumsum
+from isotopic_states import hasBlobLayout, readIsotopicStates
 
 ###############################################################################
 ###############################################################################
@@ -68,6 +69,12 @@ class Query(object) :
     The final time over which this Query is operating.
     """
 
+    states = None
+    """
+    The isotopes of each isotopic state, read through isotopic_states.py when
+    the IsotopicStates table holds a blob per composition.
+    """
+
     isoToInd = {}
     """
     A mapping of codes to indices for the isotope dimension.
@@ -110,8 +117,18 @@ class Query(object) :
             raise QueryException, "Error: " + queryType +\
                         " is not a recognized Query type at this time."
 
-        # Initialize the SQL.
-        if 'material' == queryType :
+        self.conn = sqlite3.connect(file)
+
+        # Initialize the SQL. Material queries join the row per isotope
+        # layout of IsotopicStates directly, and expand each state of the blob
+        # layout through the decoder in isotopic_states.py.
+        if 'material' == queryType and hasBlobLayout(self.conn) :
+          self.states = readIsotopicStates(self.conn)
+          self.qStmt = SqlStmt("Transactions.Time, Transactions.senderID, " + \
+              "Transactions.receiverID, IsotopicStates.ID ", \
+              "Transactions, IsotopicStates",  "Transactions.Time >= " + str(t0) + " AND " + \
+              "Transactions.Time < " + str(tf) )  
+        elif 'material' == queryType :
           self.qStmt = SqlStmt("Transactions.Time, Transactions.senderID, " + \
               "Transactions.receiverID, IsotopicStates.IsoID, IsotopicStates.value ", \
               "Transactions, IsotopicStates",  "Transactions.Time >= " + str(t0) + " AND " + \
@@ -124,8 +141,6 @@ class Query(object) :
               "Transactions.Time >= " + str(t0) + " AND " + \
               "Transactions.Time < " + str(tf) )
 
-        self.conn = sqlite3.connect(file)
-
         # Generate isotope maps.
         isos = getIsoList()
         for index, iso in enumerate(isos) :
@@ -381,8 +396,10 @@ class Query(object) :
         c = self.conn.cursor()
 
         actList = []
-        c.execute("SELECT Agents.ID FROM Agents, Transactions " + \
-                "WHERE Agents.EnterDate + Agents.LeaveDate > ? " + \
+        c.execute("SELECT Agents.ID FROM Agents " + \
+                "LEFT JOIN AgentExits ON Agents.ID = AgentExits.ID, " + \
+                "Transactions " + \
+                "WHERE Agents.EnterDate + AgentExits.LeaveDate > ? " + \
                 "AND Agents.EnterDate <= ? AND " + \
                 "(Agents.ID = Transactions.SenderID OR " + \
                 "Agents.ID = Transactions.ReceiverID) ", (self.t0, self.tf))
@@ -449,8 +466,10 @@ class Query(object) :
                 time = row[0] - self.t0
                 fFac = row[1]
                 tFac = row[2]
-                nIso = row[3]
-                mIso = row[4]
+                if self.states is None :
+                    isos = [(row[3], row[4])]
+                else :
+                    isos = self.states[row[3]].items()
 
                 # Get the indexes for the 'from' and 'to' dimensions.
                 d = self.conn.cursor()
@@ -465,7 +484,8 @@ class Query(object) :
                 for roe in d :
                     toInd = actList.index(roe[0])
 
-                self.data[time][fromInd][toInd][self.isoToInd[nIso]] += mIso
+                for nIso, mIso in isos :
+                    self.data[time][fromInd][toInd][self.isoToInd[nIso]] += mIso
 
             # Store the labels.
             self.dataLabels[0] = range(self.t0, self.tf)
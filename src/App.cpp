@@ -8,6 +8,8 @@
 #include "Model.h"
 #include "BookKeeper.h"
 #include "Timer.h"
+#include "RecipeLibrary.h"
+#include "Material.h"
 #include "CycException.h"
 #include "Env.h"
 #include "Logger.h"
@@ -34,6 +36,17 @@ int main(int argc, char* argv[]) {
     ("verb,v", po::value<string>(), vmessage.c_str())
     ("output-path,o", po::value<string>(), "output path")
     ("input-file", po::value<string>(), "input file")
+    ("stream-input", 
+     "stream the input file rather than parse it whole, for very large inputs; the file is not validated")
+    ("warm-decay", po::value<int>(), 
+     "decay the recipes for the whole simulation before it starts, on this many threads (0 for one per core)")
+    ("compact-output", 
+     "write each distinct composition once, and decayed compositions as differences from their parents")
+    ("blob-output", 
+     "write each composition as a single IsotopicStates row holding a blob")
+    ("compress-blobs", "compress the composition blobs (implies blob-output)")
+    ("resolve-threads", po::value<int>(), 
+     "match the markets each month on this many threads (0 for one per core)")
     ;
 
   po::variables_map vm;
@@ -110,10 +123,23 @@ int main(int argc, char* argv[]) {
   try {
     string inputFile = vm["input-file"].as<string>();
     set<string> module_types = Model::dynamic_module_types();
-    XMLFileLoader loader(inputFile);
+    XMLFileLoader loader(inputFile,true,vm.count("stream-input") > 0);
     loader.load_control_parameters();
+    if (vm.count("compact-output")) {
+      RL->setCompactOutput(true);
+    }
+    if (vm.count("blob-output") || vm.count("compress-blobs")) {
+      RL->setBlobOutput(true,vm.count("compress-blobs") > 0);
+    }
     loader.load_recipes();
+    if (vm.count("warm-decay")) {
+      RL->prewarmDecayCache(TI->simDur(), Material::decayInterval(),
+                            vm["warm-decay"].as<int>());
+    }
     loader.load_dynamic_modules(module_types);
+    if (vm.count("resolve-threads")) {
+      TI->setResolveThreads(vm["resolve-threads"].as<int>());
+    }
   } catch (CycException e) {
     CLOG(LEV_ERROR) << e.what();
   }
@@ -5,14 +5,17 @@
 using namespace std;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-QueryEngine::QueryEngine() {
-  spawned_children_ = set<QueryEngine*>();
-}
+QueryEngine::QueryEngine() {}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 QueryEngine::~QueryEngine() {
+  clearSpawnedChildren();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QueryEngine::clearSpawnedChildren() {
   while (!spawned_children_.empty()) {
-    QueryEngine* qe_child = *spawned_children_.begin();
+    QueryEngine* qe_child = spawned_children_.begin()->second;
     spawned_children_.erase(spawned_children_.begin());
     if (qe_child) {
       delete qe_child;
@@ -23,8 +26,14 @@ QueryEngine::~QueryEngine() {
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 QueryEngine* QueryEngine::queryElement(std::string query, 
                                        int index) {
+  pair<string,int> key(query,index);
+  map<pair<string,int>,QueryEngine*>::iterator it = 
+    spawned_children_.find(key);
+  if (it != spawned_children_.end()) {
+    return it->second;
+  }
   QueryEngine* qe_child = 
     getEngineFromQuery(query,index) ;
-  spawned_children_.insert(qe_child);
+  spawned_children_[key] = qe_child;
   return qe_child;
 }
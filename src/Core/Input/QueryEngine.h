@@ -2,8 +2,9 @@
 #ifndef QUERYENGINE_H
 #define QUERYENGINE_H
 
+#include <map>
 #include <string>
-#include <set>
+#include <utility>
 
 /**
    This is a base class that defines the API used by any engine
@@ -47,7 +48,9 @@ class QueryEngine {
                                         int index = 0) = 0;
 
   /**
-     populates a child query engine based on a query and index
+     populates a child query engine based on a query and index. the 
+     child is owned by this engine, which returns the same child when 
+     the same query and index are repeated
      @param query the query
      @param index the index of the queried element
      @return a initialized query engine based on the query and index
@@ -65,8 +68,15 @@ class QueryEngine {
   virtual QueryEngine* getEngineFromQuery(std::string query,
                                           int index) = 0;
 
+  /**
+     deletes the children spawned by queryElement(), e.g. once they no 
+     longer describe the derived engine's state
+   */
+  void clearSpawnedChildren();
+
  private:
-  std::set<QueryEngine*> spawned_children_;
+  /// the children spawned by each query and index
+  std::map<std::pair<std::string,int>,QueryEngine*> spawned_children_;
 };
 
 #include "CycException.h"
@@ -3,6 +3,7 @@
 #include "XMLFileLoader.h"
 
 #include <fstream>
+#include <vector>
 
 #include "XMLQueryEngine.h"
 
@@ -17,10 +18,22 @@ using namespace boost;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 XMLFileLoader::XMLFileLoader(std::string load_filename, 
-                             bool use_main_schema)  {
+                             bool use_main_schema,
+                             bool stream) : 
+  file_(load_filename), stream_(stream) {
   
   initialize_module_paths();
 
+  if (stream_) {
+    ifstream file_stream(file_.c_str());
+    if (!file_stream) {
+      throw CycIOException("The file '" + file_
+                           + "' could not be loaded.");
+    }
+    CLOG(LEV_DEBUG4) << "streaming the file: " << file_;
+    return;
+  }
+
   stringstream input("");
   loadStringstreamFromFile(input,load_filename);
   if (use_main_schema) {
@@ -58,6 +71,10 @@ std::string XMLFileLoader::pathToMainSchema() {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void XMLFileLoader::applySchema(std::stringstream &schema) {
+  if (stream_) {
+    throw CycLoadXMLException("The streamed file '" + file_
+                              + "' can not be validated against a schema.");
+  }
   parser_->validateFileAgaisntSchema(schema);
 }
 
@@ -72,9 +89,14 @@ void XMLFileLoader::initialize_module_paths() {
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 void XMLFileLoader::load_recipes() {
+  string query = "/*/recipe";
+  if (stream_) {
+    streamElements("recipe",query);
+    return;
+  }
+
   XMLQueryEngine xqe(*parser_);
 
-  string query = "/*/recipe";
   int numRecipes = xqe.nElementsMatchingQuery(query);
   for (int i=0; i<numRecipes; i++) {
     QueryEngine* qe = xqe.queryElement(query,i);
@@ -93,6 +115,11 @@ void XMLFileLoader::load_dynamic_modules(std::set<std::string>& module_types) {
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void XMLFileLoader::load_modules_of_type(std::string type, 
                                          std::string query_path) {  
+  if (stream_) {
+    streamElements(type,query_path);
+    return;
+  }
+
   XMLQueryEngine xqe(*parser_);
   
   int numModels = xqe.nElementsMatchingQuery(query_path);
@@ -104,10 +131,90 @@ void XMLFileLoader::load_modules_of_type(std::string type,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void XMLFileLoader::load_control_parameters() {
-  XMLQueryEngine xqe(*parser_);
-
   string query = "/*/control";
+  if (stream_) {
+    streamElements("control",query);
+    return;
+  }
+
+  XMLQueryEngine xqe(*parser_);
   QueryEngine* qe = xqe.queryElement(query);
   TI->load_simulation(qe);
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void XMLFileLoader::streamElements(std::string type, 
+                                   std::string query_path) {
+  // the element name, or *, at each depth of the path
+  vector<string> steps;
+  stringstream path(query_path);
+  string step;
+  while (getline(path,step,'/')) {
+    if (!step.empty())
+      steps.push_back(step);
+  }
+  int last = steps.size() - 1;
+
+  int n = 0;
+  boost::shared_ptr<XPathCache> cache;
+  try {
+    xmlpp::TextReader reader(file_);
+    bool more = reader.read();
+    while (more) {
+      if (reader.get_node_type() != xmlpp::TextReader::Element) {
+        more = reader.read();
+        continue;
+      }
+
+      // skip past the subtree of any element off the path
+      int depth = reader.get_depth();
+      string name = reader.get_name();
+      if (depth > last ||
+          (steps.at(depth) != "*" && steps.at(depth) != name)) {
+        more = reader.next();
+        continue;
+      }
+      if (depth < last) {
+        more = reader.read();
+        continue;
+      }
+
+      // the expanded element only lasts until the reader moves on, so
+      // its engine is freed first
+      xmlpp::Node* node = reader.expand();
+      if (!node) {
+        throw CycLoadXMLException("Could not expand an element at " 
+                                  + query_path);
+      }
+      if (!cache) {
+        // the expanded elements share the reader's document
+        cache = boost::shared_ptr<XPathCache>(
+          new XPathCache(node->cobj()->doc));
+      }
+      {
+        XMLQueryEngine xqe(node,cache);
+        loadElement(type,&xqe);
+      }
+      n++;
+      more = reader.next();
+    }
+  } catch(const xmlpp::exception& ex) {
+    throw CycLoadXMLException("Error streaming xml file: " + 
+                              string(ex.what()));
+  }
+
+  CLOG(LEV_DEBUG3) << "streamed " << n << " elements at " << query_path
+                   << " from " << file_;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void XMLFileLoader::loadElement(std::string type, QueryEngine* qe) {
+  if ("control" == type) {
+    TI->load_simulation(qe);
+  } else if ("recipe" == type) {
+    RecipeLibrary::load_recipe(qe);
+  } else {
+    Model::initializeSimulationEntity(type,qe);
+  }
+}
   
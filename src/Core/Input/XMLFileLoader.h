@@ -9,9 +9,19 @@
 #include <boost/shared_ptr.hpp>
 #include "XMLParser.h"
 
+class QueryEngine;
+
 /**
    a class that encapsulates the methods needed to load input to
    a cyclus simulation from xml
+
+   By default the whole file is parsed into a document, which may be
+   validated against a schema and is then queried for each kind of
+   input. A file may instead be streamed: each load method then reads
+   through the file with a TextReader, expanding only the elements it 
+   loads, one at a time, so that the memory used is bounded by the 
+   largest of them rather than by the file. A streamed file can not be
+   validated.
  */
 class XMLFileLoader {
  public:    
@@ -19,9 +29,12 @@ class XMLFileLoader {
      Constructor to create a new XML for loading
      @param load_filename The filename for the file to be loaded
      @param use_main_schema whether or not to use the main schema to 
-     validate the file
+     validate the file, ignored if the file is streamed
+     @param stream whether to stream the file rather than parse it
+     whole
   */
-  XMLFileLoader(std::string load_filename, bool use_main_schema=true);
+  XMLFileLoader(std::string load_filename, bool use_main_schema=true,
+                bool stream=false);
   
   /**
      @return the path to the main file schema (cyclus.rng)
@@ -31,6 +44,7 @@ class XMLFileLoader {
   /**
      applies a schema agaisnt the parser used by the file loader
      @param schema the schema representation
+     @throw CycLoadXMLException if the file is streamed
    */
   void applySchema(std::stringstream &schema);
 
@@ -75,9 +89,32 @@ class XMLFileLoader {
   void loadStringstreamFromFile(std::stringstream &stream,
                                 std::string file);
 
+  /**
+     streams the file, loading each element at a path
+     @param type the type of element: "control", "recipe", or a module
+     type
+     @param query_path the absolute path to the elements, each step of 
+     which is an element name or *
+   */
+  void streamElements(std::string type, std::string query_path);
+
+  /**
+     loads an element of a type
+     @param type the type of element: "control", "recipe", or a module
+     type
+     @param qe the query engine of the element
+   */
+  void loadElement(std::string type, QueryEngine* qe);
+
  private:
-  /// the parser
+  /// the parser, if the file is not streamed
   boost::shared_ptr<XMLParser> parser_;
+
+  /// the name of the file
+  std::string file_;
+
+  /// whether the file is streamed
+  bool stream_;
 };
 
 
@@ -1,5 +1,6 @@
 // XMLQueryEngine.cpp
 // Implements class for querying XML snippets
+#include <cctype>
 #include <iostream>
 #include <sstream>
 
@@ -11,39 +12,157 @@ using namespace std;
 using namespace boost;
 using namespace xmlpp;
 
+namespace {
+  /// true if a query is a plain element name, i.e. an XPath child step
+  bool isElementName(const std::string& query) {
+    if (query.empty() || !(isalpha(query[0]) || query[0] == '_'))
+      return false;
+    for (int i = 1; i < query.size(); i++) {
+      char c = query[i];
+      if (!(isalnum(c) || c == '_' || c == '-' || c == '.'))
+        return false;
+    }
+    return true;
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+XPathCache::XPathCache(xmlDoc* doc) : context_(0) {
+  context_ = xmlXPathNewContext(doc);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+XPathCache::~XPathCache() {
+  map<string,xmlXPathCompExpr*>::iterator it;
+  for (it = expressions_.begin(); it != expressions_.end(); it++) {
+    xmlXPathFreeCompExpr(it->second);
+  }
+  if (context_)
+    xmlXPathFreeContext(context_);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+xmlpp::NodeSet XPathCache::find(xmlpp::Node* node, const std::string& query) {
+  xmlXPathCompExpr* expression = 0;
+  map<string,xmlXPathCompExpr*>::iterator it = expressions_.find(query);
+  if (it != expressions_.end()) {
+    expression = it->second;
+  } else {
+    expression = xmlXPathCompile((const xmlChar*)query.c_str());
+    if (!expression)
+      throw CycNodeTypeException("Invalid XPath: " + query);
+    expressions_[query] = expression;
+  }
+
+  context_->doc = node->cobj()->doc;
+  context_->node = node->cobj();
+  xmlXPathObject* result = xmlXPathCompiledEval(expression,context_);
+  if (!result)
+    throw CycNodeTypeException("Could not evaluate XPath: " + query);
+
+  if (result->type != XPATH_NODESET) {
+    xmlXPathFreeObject(result);
+    throw CycNodeTypeException("XPath " + query + " is not a node set.");
+  }
+
+  // libxml++ keeps the wrapper of each node in its _private field, 
+  // and skips namespace declarations, which have none
+  NodeSet nodes;
+  xmlNodeSet* nodeset = result->nodesetval;
+  if (nodeset) {
+    nodes.reserve(nodeset->nodeNr);
+    for (int i = 0; i < nodeset->nodeNr; i++) {
+      xmlNode* cnode = nodeset->nodeTab[i];
+      if (!cnode || cnode->type == XML_NAMESPACE_DECL)
+        continue;
+      if (!cnode->_private) {
+        // a node libxml++ has not wrapped; let it evaluate the query
+        xmlXPathFreeObject(result);
+        return node->find(query);
+      }
+      nodes.push_back(static_cast<Node*>(cnode->_private));
+    }
+  }
+  xmlXPathFreeObject(result);
+  return nodes;
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 XMLQueryEngine::XMLQueryEngine(XMLParser& parser) : current_node_(0) {
   current_node_ = parser.document()->get_root_node();
+  xpath_cache_ = boost::shared_ptr<XPathCache>(new XPathCache(current_node_->cobj()->doc));
+  indexed_ = false;
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 XMLQueryEngine::XMLQueryEngine(xmlpp::Node* node) : current_node_(0) {
   current_node_ = node;
+  xpath_cache_ = boost::shared_ptr<XPathCache>(new XPathCache(current_node_->cobj()->doc));
+  indexed_ = false;
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
-int XMLQueryEngine::nElements() {
-  int n = 0;
+XMLQueryEngine::XMLQueryEngine(xmlpp::Node* node, 
+                               boost::shared_ptr<XPathCache> cache) : 
+  current_node_(node), xpath_cache_(cache), indexed_(false) {}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+void XMLQueryEngine::setCurrentNode(xmlpp::Node* node) {
+  if (node->cobj()->doc != current_node_->cobj()->doc)
+    xpath_cache_ = boost::shared_ptr<XPathCache>(new XPathCache(node->cobj()->doc));
+  current_node_ = node;
+  indexed_ = false;
+  elements_.clear();
+  children_.clear();
+  clearSpawnedChildren();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+void XMLQueryEngine::indexChildren() {
+  if (indexed_)
+    return;
   const Node::NodeList nodelist = current_node_->get_children();  
   Node::NodeList::const_iterator it;
   for (it = nodelist.begin(); it != nodelist.end(); it++) {
-    const Element* element = dynamic_cast<const Element*>(*it);
-    if (element) 
-      n++;
+    Element* element = dynamic_cast<Element*>(*it);
+    if (element) {
+      elements_.push_back(element);
+      // an XPath name test only matches elements without a namespace
+      if (!element->cobj()->ns)
+        children_[element->get_name()].push_back(element);
+    }
   }
-  return n;
+  indexed_ = true;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+xmlpp::NodeSet XMLQueryEngine::find(const std::string& query) {
+  if (!isElementName(query))
+    return xpath_cache_->find(current_node_,query);
+
+  indexChildren();
+  map<string,NodeSet>::iterator it = children_.find(query);
+  if (it == children_.end())
+    return NodeSet();
+  return it->second;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+int XMLQueryEngine::nElements() {
+  indexChildren();
+  return elements_.size();
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 int XMLQueryEngine::nElementsMatchingQuery(std::string query) {
-  const NodeSet nodeset = current_node_->find(query);
+  const NodeSet nodeset = find(query);
   return nodeset.size();
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 std::string XMLQueryEngine::getElementContent(std::string query,
                                               int index) {
-  const NodeSet nodeset = current_node_->find(query);
+  const NodeSet nodeset = find(query);
 
   if (nodeset.empty())
     throw CycNullQueryException("Could not find a node by the name: " 
@@ -77,25 +196,18 @@ std::string XMLQueryEngine::getElementContent(std::string query,
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 std::string XMLQueryEngine::getElementName(int index) {
-  vector<Element*> elements;
-  const Node::NodeList nodelist = current_node_->get_children();
-  Node::NodeList::const_iterator it;
-  for (it = nodelist.begin(); it != nodelist.end(); it++) {
-    Element* element = dynamic_cast<Element*>(*it);
-    if (element) 
-      elements.push_back(element);
-  }
-  if (elements.size() < index+1)
+  indexChildren();
+  if (elements_.size() < index+1)
     throw CycIndexException("Index exceeds number of elements in node: " 
                             + current_node_->get_name());
-  return elements.at(index)->get_name();
+  return elements_.at(index)->get_name();
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 QueryEngine* XMLQueryEngine::getEngineFromQuery(std::string query,
                                                 int index) {
   
-  const NodeSet nodeset = current_node_->find(query);
+  const NodeSet nodeset = find(query);
 
   if (nodeset.size() < index+1)
     throw CycIndexException("Index exceeds number of nodes in query: " 
@@ -108,5 +220,5 @@ QueryEngine* XMLQueryEngine::getEngineFromQuery(std::string query,
     throw CycNodeTypeException("Node: " + element->get_name() +
                                " is not an Element node.");
 
-  return new XMLQueryEngine(element);
+  return new XMLQueryEngine(element,xpath_cache_);
 }
@@ -2,16 +2,59 @@
 #if !defined(_XMLQUERYENGINE_H)
 #define _XMLQUERYENGINE_H
 
+#include <map>
 #include <string>
+#include <vector>
 
 #include "QueryEngine.h"
 #include "XMLParser.h"
 #include <libxml++/libxml++.h>
+#include <libxml/xpath.h>
+#include <boost/shared_ptr.hpp>
+
+/**
+   @class XPathCache
+
+   The compiled XPath expressions of the queries made of a document,
+   shared by the query engines of that document so that each query is
+   compiled only once.
+*/
+class XPathCache {
+ public:
+  /**
+     constructor given the document to be queried
+     @param doc the document
+   */
+  XPathCache(xmlDoc* doc);
+
+  /// destructor, which frees the compiled expressions
+  ~XPathCache();
+
+  /**
+     evaluates a query from a node
+     @param node the context node
+     @param query the XPath query
+     @return the nodes matching the query
+   */
+  xmlpp::NodeSet find(xmlpp::Node* node, const std::string& query);
+
+ private:
+  /// the context the expressions are evaluated in
+  xmlXPathContext* context_;
+
+  /// the compiled expression of each query
+  std::map<std::string,xmlXPathCompExpr*> expressions_;
+};
 
 /**
    @class XMLQueryEngine
 
    A class for extracting information from a given XML parser
+
+   A query that is simply an element name is answered from an index of
+   the current node's child elements by name, built in one pass the 
+   first time it is needed. Other queries are evaluated as XPath 
+   expressions, compiled once per document by an XPathCache.
 */
 class XMLQueryEngine : public QueryEngine {
  public:
@@ -21,6 +64,20 @@ class XMLQueryEngine : public QueryEngine {
   */
   XMLQueryEngine(XMLParser& parser);
 
+  /**
+     constructor given a node, e.g. one expanded by a TextReader
+     @param node the node to set as the current node
+  */
+  XMLQueryEngine(xmlpp::Node* node);
+
+  /**
+     constructor given a node and the cache of its document, e.g. one 
+     shared by every element a TextReader expands
+     @param node the node to set as the current node
+     @param cache the XPath cache of the node's document
+  */
+  XMLQueryEngine(xmlpp::Node* node, boost::shared_ptr<XPathCache> cache);
+
   /// virtual destructor
   virtual ~XMLQueryEngine() {};
     
@@ -54,12 +111,6 @@ class XMLQueryEngine : public QueryEngine {
                                         int index = 0);
 
  protected:
-  /**
-     constructor given a node
-     @param node the node to set as the current node
-  */
-  XMLQueryEngine(xmlpp::Node* node);
-
   /**
      every derived query engine must return a new instance initialized
      by a query.
@@ -70,13 +121,37 @@ class XMLQueryEngine : public QueryEngine {
   virtual QueryEngine* getEngineFromQuery(std::string query,
                                           int index);
   /**
-     sets the current node to a given node
+     sets the current node to a given node, dropping the child index 
+     and the children spawned from the previous one
      @param node the new current node
    */
   void setCurrentNode(xmlpp::Node* node);
 
  private:
+  /**
+     finds the nodes matching a query from the current node
+     @param query the query
+   */
+  xmlpp::NodeSet find(const std::string& query);
+
+  /**
+     indexes the child elements of the current node, if not yet done
+   */
+  void indexChildren();
+
   xmlpp::Node* current_node_;
+
+  /// the XPath cache of the current node's document
+  boost::shared_ptr<XPathCache> xpath_cache_;
+
+  /// true if the child elements have been indexed
+  bool indexed_;
+
+  /// the child elements, in document order
+  std::vector<xmlpp::Element*> elements_;
+
+  /// the child elements without a namespace, by name
+  std::map<std::string,xmlpp::NodeSet> children_;
 };
 
 #include "CycException.h"
@@ -5,6 +5,8 @@
 #include "Message.h"
 #include "Logger.h"
 
+class Model;
+
 /**
    An abstract class for deriving simulation entities 
    that can communicate via the Message class. 
@@ -39,6 +41,10 @@
 class Communicator {
   
 public:
+  Communicator() 
+    : route_cached_(false), route_from_model_(false), 
+      route_up_(NULL), route_up_model_(NULL) { };
+
   virtual ~Communicator() {
     MLOG(LEV_DEBUG4) << "communicator " << this << " destructed";
     for (int i = 0; i < tracked_messages_.size(); i++) {
@@ -50,7 +56,35 @@ public:
 
   friend class Message;
 
+  /**
+     Forgets the cached next stop up from this communicator, so that it 
+     is looked up again the next time a message is sent on from here. 
+     Models call this whenever their place in the model tree changes. 
+   */
+  void invalidateRoute() { route_cached_ = false; };
+
 private:
+  /**
+     true if the next stop up from this communicator is cached 
+   */
+  bool route_cached_;
+
+  /**
+     true if this communicator is a Model, so that messages it owns can 
+     find their own way up 
+   */
+  bool route_from_model_;
+
+  /**
+     the next stop up from this communicator, its parent, or NULL if it 
+     is at the top of the model tree and messages go to their receivers 
+   */
+  Communicator* route_up_;
+
+  /**
+     the parent model that route_up_ is 
+   */
+  Model* route_up_model_;
 
   /**
      Models communicate desires for material, etc. by sending 
@@ -62,6 +96,20 @@ private:
    */
   virtual void receiveMessage(msg_ptr msg) = 0;
 
+  /**
+     Receives a batch of messages sent on together with 
+     Message::sendBatch(). By default each message is received in 
+     turn with receiveMessage(); communicators that only pass messages 
+     on should send the batch on whole with Message::sendBatch(). 
+
+     @param msgs the messages to be received 
+   */
+  virtual void receiveMessages(MessageBatch msgs) {
+    for (int i = 0; i < msgs.size(); i++) {
+      receiveMessage(msgs.at(i));
+    }
+  }
+
   std::vector<msg_ptr> tracked_messages_;
 
   /** 
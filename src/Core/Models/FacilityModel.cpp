@@ -7,6 +7,7 @@
 #include "BookKeeper.h"
 #include "QueryEngine.h"
 #include "InstModel.h"
+#include "Transaction.h"
 
 #include <stdlib.h>
 #include <sstream>
@@ -101,6 +102,16 @@ InstModel* FacilityModel::facInst() {
   return dynamic_cast<InstModel*>( parent() );
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FacilityModel::sendOrders(const std::vector<Transaction>& orders) {
+  MessageBatch batch;
+  for (int i = 0; i < orders.size(); i++) {
+    Transaction order = orders.at(i);
+    batch.push_back(msg_ptr(new Message(this, order.market(), order)));
+  }
+  Message::sendBatch(batch);
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FacilityModel::handleDailyTasks(int time, int day){
   // facilities who have more intricate details should utilize this function
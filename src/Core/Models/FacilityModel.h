@@ -12,6 +12,7 @@
 
 // forward declare Material class to avoid full inclusion and dependency
 class Material;
+class Transaction;
 class InstModel;
 
 /**
@@ -122,6 +123,16 @@ class FacilityModel : public TimeAgent, public Communicator,
    */ 
   virtual void receiveMessage(msg_ptr msg)=0;
 
+  /**
+     Sends offers and/or requests up to the markets for their 
+     commodities as a single batch of messages. 
+
+     @param orders the offers and requests to send 
+     @exception CycMarketlessCommodException an order's commodity has 
+     no market 
+   */
+  void sendOrders(const std::vector<Transaction>& orders);
+
 /* ------------------- */ 
 
 
@@ -94,9 +94,9 @@ void InstModel::throwErrorIfPrototypeIsntAvailable(Prototype* p) {
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
 std::string InstModel::str() {
-  try {
-    return Model::str() + " in region" + parent()->name();
-  } catch (CycIndexException err) {
+  if (tryParent() != NULL) {
+    return Model::str() + " in region" + tryParent()->name();
+  } else {
     return Model::str() + " with no region.";
   }
 }
@@ -132,6 +132,11 @@ void InstModel::receiveMessage(msg_ptr msg){
   msg->sendOn();
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
+void InstModel::receiveMessages(MessageBatch msgs){
+  Message::sendBatch(msgs);
+}
+
 void InstModel::handleTick(int time) {
   // tell all of the institution's child models to handle the tick
   int currsize = children_.size();
@@ -82,6 +82,13 @@ class InstModel : public TimeAgent, public Communicator {
      default InstModel receiver is to ignore message. 
    */
   virtual void receiveMessage(msg_ptr msg);
+
+  /**
+     default InstModel batch receiver sends the batch on whole. 
+     institutions that intercept messages in receiveMessage() should 
+     also intercept batches here. 
+   */
+  virtual void receiveMessages(MessageBatch msgs);
   
   /**
      Each institution is prompted to do its beginning-of-time-step 
@@ -16,6 +16,7 @@ list<MarketModel*> MarketModel::markets_;
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
 MarketModel::MarketModel() {
   setModelType("Market"); 
+  uses_order_book_ = false;
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
@@ -33,16 +34,19 @@ MarketModel::~MarketModel() {
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
-MarketModel* MarketModel::marketForCommod(std::string commod) {
-  MarketModel* market = NULL;
+MarketModel* MarketModel::findMarket(std::string commod) {
   list<MarketModel*>::iterator mkt;
   for (mkt=markets_.begin(); mkt!=markets_.end(); ++mkt){
     if ((*mkt)->commodity() == commod) {
-      market = *mkt;
-      break;
+      return *mkt;
     }
   }
+  return NULL;
+}
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
+MarketModel* MarketModel::marketForCommod(std::string commod) {
+  MarketModel* market = findMarket(commod);
   if (market == NULL) {
     string err_msg = "No market found for commodity '";
     err_msg += commod + "'.";
@@ -63,6 +67,30 @@ void MarketModel::enterSimulationAsCoreEntity() {
   MarketModel::registerMarket(this);
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
+void MarketModel::match() {
+  if (uses_order_book_) {
+    order_book_.add(messages_);
+    messages_.clear();
+    order_book_.plan();
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
+void MarketModel::useOrderBook() {
+  uses_order_book_ = true;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
+void MarketModel::applyOrderBook() {
+  vector<MatchedOrders> matches = order_book_.apply();
+  for (vector<MatchedOrders>::iterator it = matches.begin(); 
+       it != matches.end(); it++) {
+    orders_.push_back(it->first);
+    orders_.push_back(it->second);
+  }
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
 void MarketModel::setCommodity(std::string name) {
   commodity_ = name;
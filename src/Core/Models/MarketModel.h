@@ -8,6 +8,7 @@
 
 #include "Model.h"
 #include "Communicator.h"
+#include "OrderBook.h"
 #include "CycException.h"
 
 class QueryEngine;
@@ -89,6 +90,16 @@ class MarketModel : public Model, public Communicator {
    */
   static MarketModel* marketForCommod(std::string commod);
 
+  /**
+     Queries the list of known markets for one associated with the 
+     commodity  
+
+     @param commod a string naming the commodity whose market is of 
+     interest 
+     @return the market, or NULL if the commodity has no market 
+   */
+  static MarketModel* findMarket(std::string commod);
+
   /**
      enters the market into the simulation
    */
@@ -138,9 +149,23 @@ public:
    */
   std::string commodity() { return commodity_; } ;
 
+  /**
+     Optionally computes this market's matches ahead of resolve(). 
+     The Timer may run the match() of different markets concurrently, 
+     so it must only read and write this market's own members: it may 
+     not send messages, approve transfers, log or touch any other 
+     simulation state. Every market's resolve() is then called in 
+     turn, in registration order, to carry the matches out. By 
+     default, markets that use the order book (see useOrderBook()) 
+     move the messages they received into it and plan its matches 
+     here; other markets do all of their work in resolve(). 
+   */
+  virtual void match();
+
   /**
      Primary funcation of a Market is to resolve the set of 
-     requests with the set of offers. 
+     requests with the set of offers. An OrderBook can do the 
+     matching for markets that clear by price. 
    */
   virtual void resolve() = 0;
 
@@ -164,6 +189,28 @@ protected:
      every market knows its number of firm orders 
    */
   int firmOrders_;
+
+  /**
+     makes match() plan this market's trades with its order book, so 
+     that they are computed while other markets match 
+   */
+  void useOrderBook();
+
+  /**
+     carries out the matches planned by match(), adding each matched 
+     offer and request to orders_. called from resolve(). 
+   */
+  void applyOrderBook();
+
+  /**
+     the order book of a market that clears by price 
+   */
+  OrderBook order_book_;
+
+  /**
+     true if match() plans with the order book 
+   */
+  bool uses_order_book_;
   
 /* ------------------- */ 
   
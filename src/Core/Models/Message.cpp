@@ -64,9 +64,9 @@ msg_ptr Message::clone() {
   CLOG(LEV_DEBUG3) << "Message " << this << "was cloned.";
 
   msg_ptr new_msg(new Message(*this));
-  try {
+  if (hasTrans()) {
     new_msg->trans_ = trans_->clone();
-  } catch(CycNullMsgParamException) { }
+  }
   return new_msg;
 }
 
@@ -99,36 +99,143 @@ void Message::sendOn() {
                    << next_stop << " completed";
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Message::sendBatch(MessageBatch batch) {
+  // the messages that can't travel with the batch are sent on singly
+  Communicator* owner = NULL;
+  MessageBatch moving, others;
+  for (MessageBatch::iterator it = batch.begin(); it != batch.end(); it++) {
+    msg_ptr msg = *it;
+    if (msg->dead_) {
+      continue;
+    }
+    cacheRoute(msg->curr_owner_);
+    if (msg->dir_ != UP_MSG 
+        || msg->path_stack_.back() != msg->curr_owner_
+        || !msg->curr_owner_->route_from_model_) {
+      msg->sendOn();
+    } else if (owner == NULL || msg->curr_owner_ == owner) {
+      owner = msg->curr_owner_;
+      moving.push_back(msg);
+    } else {
+      others.push_back(msg);
+    }
+  }
+  if (moving.empty()) {
+    return;
+  }
+
+  Communicator* next_stop = batchDest(owner,moving);
+  if (next_stop != NULL) {
+    deliverBatch(next_stop,moving);
+  } else {
+    // past the top of the hierarchy, grouped by receiver in batch order
+    vector<pair<Communicator*,MessageBatch> > groups;
+    for (MessageBatch::iterator it = moving.begin(); 
+         it != moving.end(); it++) {
+      int i = 0;
+      while (i < groups.size() && groups[i].first != (*it)->receiver_) {
+        i++;
+      }
+      if (i == groups.size()) {
+        groups.push_back(make_pair((*it)->receiver_,MessageBatch()));
+      }
+      groups[i].second.push_back(*it);
+    }
+    for (int i = 0; i < groups.size(); i++) {
+      deliverBatch(groups[i].first,groups[i].second);
+    }
+  }
+
+  if (!others.empty()) {
+    sendBatch(others);
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Communicator* Message::batchDest(Communicator* owner, 
+                                 const MessageBatch& batch) {
+  Model* next_model = owner->route_up_model_;
+  if (next_model == NULL) {
+    return NULL;
+  }
+  for (MessageBatch::const_iterator it = batch.begin(); 
+       it != batch.end(); it++) {
+    (*it)->tallyOrder(next_model);
+  }
+  return owner->route_up_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Message::deliverBatch(Communicator* next_stop, MessageBatch& batch) {
+  if (next_stop == NULL) {
+    throw CycNoMsgReceiverException();
+  }
+
+  for (MessageBatch::iterator it = batch.begin(); it != batch.end(); it++) {
+    msg_ptr msg = *it;
+    msg->setNextDest(next_stop);
+    next_stop->trackMessage(msg);
+    msg->validateForSend();
+    msg->curr_owner_ = next_stop;
+  }
+
+  CLOG(LEV_DEBUG1) << "Batch of " << batch.size() << " messages going to comm "
+                   << next_stop << " {";
+
+  next_stop->receiveMessages(batch);
+
+  CLOG(LEV_DEBUG1) << "} Batch send to comm " << next_stop << " completed";
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Message::autoSetNextDest() {
   if (path_stack_.back() != curr_owner_) {
     return;
   }
 
-  Model* curr = dynamic_cast<Model*>(curr_owner_);
-  if (curr == NULL) {
+  cacheRoute(curr_owner_);
+  if (!curr_owner_->route_from_model_) {
     // cannot set auto-set (e.g. curr_owner_ is not a Model*
     return;
   }
 
   Communicator* next_dest;
-  try {
-    Model* next_model = curr->parent();
+  Model* next_model = curr_owner_->route_up_model_;
+  if (next_model != NULL) {
     tallyOrder(next_model);
-    next_dest = dynamic_cast<Communicator*>(next_model);
-  } catch (CycIndexException err) {
+    next_dest = curr_owner_->route_up_;
+  } else {
     next_dest = receiver_;
   }
   setNextDest(next_dest);
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Message::cacheRoute(Communicator* comm) {
+  if (comm->route_cached_) {
+    return;
+  }
+
+  Model* curr = dynamic_cast<Model*>(comm);
+  comm->route_from_model_ = (curr != NULL);
+  comm->route_up_model_ = NULL;
+  comm->route_up_ = NULL;
+  if (curr != NULL) {
+    // NULL at the top of the tree, where messages go on to their receivers
+    comm->route_up_model_ = curr->tryParent();
+    comm->route_up_ = dynamic_cast<Communicator*>(comm->route_up_model_);
+  }
+  comm->route_cached_ = true;
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Message::tallyOrder(Model* next_model) {
-  if (next_model->modelType() != "Market") {
+  if (next_model->modelType() != "Market" || !hasTrans()) {
     return;
   }
 
-  Transaction tran = trans();
+  const Transaction& tran = *trans_;
   if (tran.isOffer()) {
     Message::offer_qtys_[tran.commod()][TI->time()] += tran.resource()->quantity();
   } else {
@@ -214,6 +321,16 @@ Communicator* Message::receiver() const {
   return receiver_;
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Message::hasReceiver() const {
+  return receiver_ != NULL;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Message::hasTrans() const {
+  return trans_ != NULL;
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Transaction& Message::trans() const {
   if (trans_ == NULL) {
@@ -18,6 +18,11 @@ class Transaction;
 
 typedef boost::intrusive_ptr<Message> msg_ptr;
 
+/**
+   messages sent on together with Message::sendBatch() 
+ */
+typedef std::vector<msg_ptr> MessageBatch;
+
 /**
    An enumerative type to specify which direction 
    (up or down the class hierarchy) this message is moving. 
@@ -179,10 +184,54 @@ class Message: IntrusiveBase<Message> {
    */
   virtual void sendOn();
 
+  /**
+     Sends a batch of upward messages on together. Each stop on the way 
+     up receives the whole batch in a single call to its 
+     receiveMessages() method, rather than a receiveMessage() call per 
+     message, and the next stop is looked up once per batch. The 
+     messages still record their paths, so they are sent back down one 
+     by one with sendOn() as usual. 
+
+     Messages on their way down, killed messages, and messages whose 
+     next stop was set with setNextDest() are sent on singly. Messages 
+     with different current owners are sent on in separate batches, as 
+     are messages that leave the top of the hierarchy for different 
+     receivers. 
+
+     @param batch the messages to send on 
+   */
+  static void sendBatch(MessageBatch batch);
+
  private:
 
   void autoSetNextDest();
 
+  /**
+     returns the next stop of a batch of messages whose current owner 
+     is owner, or NULL if each message goes to its own receiver 
+
+     @param owner the current owner of the batch 
+     @param batch the messages 
+   */
+  static Communicator* batchDest(Communicator* owner, 
+                                 const MessageBatch& batch);
+
+  /**
+     moves a batch of messages on to the next stop and delivers it 
+
+     @param next_stop the communicator to receive the batch 
+     @param batch the messages 
+   */
+  static void deliverBatch(Communicator* next_stop, MessageBatch& batch);
+
+  /**
+     caches the next stop up from a communicator, if it is not already. 
+     this is the only place messages look up the model tree. 
+
+     @param comm the communicator 
+   */
+  static void cacheRoute(Communicator* comm);
+
   /**
    Keeps history of total order vs request qtys for every commodity.
    If you need more, read the implementation - it is only 10 lines.
@@ -265,11 +314,23 @@ class Message: IntrusiveBase<Message> {
    */
   Communicator* receiver() const;
 
+  /**
+     returns true if this Message has a receiver 
+   */
+  bool hasReceiver() const;
+
   /**
      Returns by reference the transaction associated with this message. 
+
+     @exception CycNullMsgParamException the message has no transaction 
    */
   Transaction& trans() const;
 
+  /**
+     returns true if this Message has a transaction 
+   */
+  bool hasTrans() const;
+
   /**
   Allows peeking in at a commodity's supply/demand balance at specific
   simulation times.
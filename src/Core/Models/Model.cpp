@@ -19,13 +19,28 @@
 #include "QueryEngine.h"
 
 #include "RegionModel.h"
+#include "Communicator.h"
 
 using namespace std;
 using namespace boost;
 
+namespace {
+  /**
+     Forgets the cached route that messages take up from a model, if it 
+     is a Communicator. Called whenever the model tree changes. 
+   */
+  void invalidateRoute(Model* model) {
+    Communicator* comm = dynamic_cast<Communicator*>(model);
+    if (comm != NULL) {
+      comm->invalidateRoute();
+    }
+  }
+}
+
 // static members
 int Model::next_id_ = 0;
 table_ptr Model::agent_table = table_ptr(new Table("Agents")); 
+table_ptr Model::agent_exit_table = table_ptr(new Table("AgentExits")); 
 vector<Model*> Model::model_list_;
 map< string, shared_ptr<DynamicModule> > Model::loaded_modules_;
 vector<void*> Model::dynamic_libraries_;
@@ -185,9 +200,9 @@ Model::~Model() {
   
   // set died on date and record it in the table
   diedOn_ = TI->time();
-  data a_don(diedOn_);
-  entry don("LeaveDate",a_don);
-  agent_table->updateRow( this->pkref(), don );
+  if (!pkref_.empty()) {
+    addExitToTable();
+  }
   
   // remove references to self
   removeFromList(this, model_list_);
@@ -280,6 +295,12 @@ void Model::setParent(Model* parent){
   } else {
     parent_ = parent;
   }
+  invalidateRoute(this);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Model* Model::tryParent(){
+  return parent_;
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -310,6 +331,7 @@ void Model::addChild(Model* child){
 		  << child->ID() << " to its list of children.";
 
   children_.push_back(child); 
+  invalidateRoute(child);
 };
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -318,6 +340,7 @@ void Model::removeChild(Model* child){
 		  << " has removed child '" << child->name() << "' ID=" 
 		  << child->ID() << " from its list of children.";
   removeFromList(child, children_);
+  invalidateRoute(child);
 };
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -379,7 +402,6 @@ void Model::define_table() {
   agent_table->addField("Prototype","VARCHAR(128)"); // e.g. Areva, AP1000
   agent_table->addField("ParentID","INTEGER");
   agent_table->addField("EnterDate","INTEGER");
-  agent_table->addField("LeaveDate","INTEGER");
   // declare the table's primary key
   agent_table->setPrimaryKey("ID");
   // add foreign keys
@@ -431,3 +453,33 @@ void Model::addToTable(){
   // record this primary key
   pkref_.push_back(id);
 }
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Model::define_exit_table() {
+  // declare the table columns
+  agent_exit_table->addField("ID","INTEGER");
+  agent_exit_table->addField("LeaveDate","INTEGER");
+  // declare the table's primary key
+  agent_exit_table->setPrimaryKey("ID");
+  // the id references the agents' id
+  key myk, theirk;
+  myk.push_back("ID");
+  theirk.push_back("ID");
+  foreign_key_ref fkref("Agents",theirk);
+  agent_exit_table->addForeignKey( foreign_key(myk,fkref) );
+  // we've now defined the table
+  agent_exit_table->tableDefined();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Model::addExitToTable(){
+  // if we haven't logged an exit yet, define the table
+  if ( !agent_exit_table->defined() )
+    Model::define_exit_table();
+
+  data an_id( this->ID() ), a_don( this->diedOn() );
+  entry id("ID",an_id), don("LeaveDate",a_don);
+  row aRow;
+  aRow.push_back(id), aRow.push_back(don);
+  agent_exit_table->addRow(aRow);
+}
@@ -187,9 +187,17 @@ class Model {
 
   /**
      return parent of this model 
+
+     @exception CycIndexException this model has no parent 
    */
   Model* parent();
 
+  /**
+     return parent of this model, or NULL if it has none (e.g. a 
+     region) 
+   */
+  Model* tryParent();
+
   /**
      return the parent' id 
    */
@@ -420,6 +428,13 @@ class Model {
      the agent database table 
    */
   static table_ptr agent_table;
+
+  /**
+     the agent exit database table. an agent's LeaveDate is appended 
+     here when it is deleted rather than updated in the agent table, 
+     so that decommissioning costs an insert rather than an update. 
+   */
+  static table_ptr agent_exit_table;
   
   /**
      return the agent table's primary key 
@@ -437,6 +452,16 @@ class Model {
    */
   void addToTable();
 
+  /**
+     Define the exit database table on the first agent's exit 
+   */
+  static void define_exit_table();
+
+  /**
+     add an agent's exit to the exit table 
+   */
+  void addExitToTable();
+
   /**
      Store information about the transactions's primary key 
    */
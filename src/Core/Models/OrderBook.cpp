@@ -0,0 +1,157 @@
+// OrderBook.cpp
+// Implements the OrderBook class
+
+#include "OrderBook.h"
+
+#include <algorithm>
+#include <list>
+
+#include "CycLimits.h"
+#include "Resource.h"
+#include "Transaction.h"
+
+using namespace std;
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+OrderBook::OrderBook() {
+  n_added_ = 0;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OrderBook::add(msg_ptr msg) {
+  Transaction& trans = msg->trans();
+  Order order;
+  order.msg = msg;
+  order.price = trans.price();
+  order.remaining = trans.resource()->quantity();
+  order.minimum = trans.minfrac() * order.remaining;
+  order.seq = n_added_++;
+  if (trans.isOffer()) {
+    offers_.push(order);
+  } else {
+    requests_.push(order);
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OrderBook::add(const std::set<msg_ptr>& msgs) {
+  for (set<msg_ptr>::const_iterator it = msgs.begin();
+       it != msgs.end(); it++) {
+    add(*it);
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int OrderBook::nOffers() const {
+  return offers_.size();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int OrderBook::nRequests() const {
+  return requests_.size();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::vector<MatchedOrders> OrderBook::match() {
+  plan();
+  return apply();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OrderBook::plan() {
+
+  // the heaps give up their orders best first. offers that can not be 
+  // filled any further are erased, so that each request only looks at 
+  // live offers; those it passes over for their minimums stay for the 
+  // others
+  list<Order> offers;
+  while (!offers_.empty()) {
+    offers.push_back(offers_.top());
+    offers_.pop();
+  }
+  vector<Order> requests;
+  while (!requests_.empty()) {
+    requests.push_back(requests_.top());
+    requests_.pop();
+  }
+
+  for (vector<Order>::iterator request = requests.begin();
+       request != requests.end(); request++) {
+    list<Order>::iterator offer = offers.begin();
+    while (offer != offers.end() && 
+           request->remaining > cyclus::eps_rsrc()) {
+      if (offer->price > request->price) {
+        break;
+      }
+
+      // a part may not be smaller than either order's minimum, but
+      // each order may still trade with the others
+      double quantity = min(offer->remaining,request->remaining);
+      if (quantity < offer->minimum - cyclus::eps_rsrc() ||
+          quantity < request->minimum - cyclus::eps_rsrc()) {
+        offer++;
+        continue;
+      }
+
+      Fill planned;
+      planned.offer = *offer;
+      planned.request = *request;
+      planned.quantity = quantity;
+      planned_.push_back(planned);
+      offer->remaining -= quantity;
+      request->remaining -= quantity;
+      if (!fillable(*offer)) {
+        offer = offers.erase(offer);
+      }
+    }
+  }
+
+  // the orders that can still be filled stay in the book
+  for (list<Order>::iterator it = offers.begin(); it != offers.end(); it++) {
+    if (fillable(*it)) {
+      offers_.push(*it);
+    }
+  }
+  for (vector<Order>::iterator it = requests.begin(); 
+       it != requests.end(); it++) {
+    if (fillable(*it)) {
+      requests_.push(*it);
+    }
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::vector<MatchedOrders> OrderBook::apply() {
+  vector<MatchedOrders> matches;
+  matches.reserve(planned_.size());
+  for (vector<Fill>::iterator it = planned_.begin(); 
+       it != planned_.end(); it++) {
+    msg_ptr offer_part = fill(it->offer,it->quantity);
+    msg_ptr request_part = fill(it->request,it->quantity);
+    offer_part->trans().matchWith(request_part->trans());
+    matches.push_back(make_pair(offer_part,request_part));
+  }
+  planned_.clear();
+  return matches;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int OrderBook::nPlanned() const {
+  return planned_.size();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool OrderBook::fillable(const Order& order) const {
+  return order.remaining > cyclus::eps_rsrc() && 
+    order.remaining >= order.minimum - cyclus::eps_rsrc();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+msg_ptr OrderBook::fill(const Order& order, double quantity) {
+  msg_ptr part = order.msg;
+  if (order.remaining - quantity > cyclus::eps_rsrc()) {
+    part = order.msg->clone();
+  }
+  part->trans().resource()->setQuantity(quantity);
+  return part;
+}
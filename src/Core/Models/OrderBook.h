@@ -0,0 +1,191 @@
+// OrderBook.h
+#if !defined(_ORDERBOOK_H)
+#define _ORDERBOOK_H
+
+#include <set>
+#include <queue>
+#include <vector>
+#include <utility>
+
+#include "Message.h"
+
+/**
+   a matched offer (first) and request (second)
+ */
+typedef std::pair<msg_ptr,msg_ptr> MatchedOrders;
+
+/**
+   @class OrderBook
+
+   A price sorted order book that markets may use to match offers with
+   requests.
+
+   Offers are kept in a heap with the cheapest first and requests in a
+   heap with the highest price first; ties go to the order added first.
+   match() takes the requests from the best down, and fills each from
+   the cheapest offers priced no higher than it, moving the smaller of
+   their remaining quantities each time. Offers are dropped from the
+   scan as soon as they can not be filled any further, so without
+   minimums in the way each offer is visited once per request it
+   trades with, plus once where a request stops, and n orders are
+   cleared in O(n log n).
+
+   An order may be partly filled. Each part is a clone of its message
+   holding only the matched quantity, except for the last part of a
+   completely filled order, which is the message itself. A part may
+   not be smaller than either order's minfrac times its quantity: if
+   it would be, that offer is passed over for the request, and both
+   remain free to trade with other orders. A partly filled order whose
+   remainder is smaller than its own minimum can not be filled any
+   further and is dropped from the book.
+
+   Matching is done in two steps. plan() decides which orders trade
+   and how much, and only reads and writes the book, so a market may
+   call it from its match() while other markets match. apply() then
+   makes the parts, pairs them with Transaction::matchWith and returns
+   them in the order they were planned, so a market need only send
+   them on. Since it clones messages and numbers transactions, apply()
+   must be called from a market's resolve(). match() does both.
+ */
+class OrderBook {
+ public:
+  /**
+     constructs an empty book
+   */
+  OrderBook();
+
+  /**
+     adds an offer or request to the book
+
+     @param msg the message of the offer or request
+   */
+  void add(msg_ptr msg);
+
+  /**
+     adds each offer and request in a set to the book, e.g. those a
+     market has received
+
+     @param msgs the messages of the offers and requests
+   */
+  void add(const std::set<msg_ptr>& msgs);
+
+  /**
+     returns the number of offers in the book
+   */
+  int nOffers() const;
+
+  /**
+     returns the number of requests in the book
+   */
+  int nRequests() const;
+
+  /**
+     matches the offers in the book with its requests. The orders left
+     over, partly filled or not, stay in the book, unless what is left 
+     of them is below their minimum.
+
+     @return the matched offers and requests, in the order they were
+     matched
+   */
+  std::vector<MatchedOrders> match();
+
+  /**
+     decides which offers and requests in the book trade and how much, 
+     without touching their messages. The orders left over stay in the 
+     book as in match(). Planned matches accumulate until apply().
+   */
+  void plan();
+
+  /**
+     carries out the planned matches
+
+     @return the matched offers and requests, in the order they were
+     planned
+   */
+  std::vector<MatchedOrders> apply();
+
+  /**
+     returns the number of matches planned but not yet applied
+   */
+  int nPlanned() const;
+
+ private:
+  /**
+     an offer or request in the book
+   */
+  struct Order {
+    msg_ptr msg;
+    double price;
+    double remaining;
+    double minimum;
+    int seq;
+  };
+
+  /**
+     a planned match: the offer and request as they were when it was 
+     planned, and the quantity they trade
+   */
+  struct Fill {
+    Order offer;
+    Order request;
+    double quantity;
+  };
+
+  /**
+     orders the offer heap: the cheapest on top, then the first added
+   */
+  struct CheapestFirst {
+    bool operator()(const Order& lhs, const Order& rhs) const {
+      if (lhs.price != rhs.price) {
+        return lhs.price > rhs.price;
+      }
+      return lhs.seq > rhs.seq;
+    }
+  };
+
+  /**
+     orders the request heap: the dearest on top, then the first added
+   */
+  struct DearestFirst {
+    bool operator()(const Order& lhs, const Order& rhs) const {
+      if (lhs.price != rhs.price) {
+        return lhs.price < rhs.price;
+      }
+      return lhs.seq > rhs.seq;
+    }
+  };
+
+  /**
+     returns true if some of an order is left, and no less than its
+     minimum
+   */
+  bool fillable(const Order& order) const;
+
+  /**
+     returns the part of an order to fill with a quantity: the order's
+     message if it is filled completely, otherwise a clone of it
+   */
+  msg_ptr fill(const Order& order, double quantity);
+
+  /**
+     the offers in the book
+   */
+  std::priority_queue<Order,std::vector<Order>,CheapestFirst> offers_;
+
+  /**
+     the requests in the book
+   */
+  std::priority_queue<Order,std::vector<Order>,DearestFirst> requests_;
+
+  /**
+     the matches planned but not yet applied
+   */
+  std::vector<Fill> planned_;
+
+  /**
+     the number of orders added so far
+   */
+  int n_added_;
+};
+
+#endif
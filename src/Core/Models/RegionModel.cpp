@@ -101,6 +101,11 @@ void RegionModel::receiveMessage(msg_ptr msg){
   msg->sendOn();
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -  
+void RegionModel::receiveMessages(MessageBatch msgs){
+  Message::sendBatch(msgs);
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -  
 void RegionModel::handleTick(int time){
   int currsize = children_.size();
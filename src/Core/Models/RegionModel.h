@@ -100,6 +100,13 @@ class RegionModel : public TimeAgent, public Communicator {
    */
   virtual void receiveMessage(msg_ptr msg);
 
+  /**
+     default RegionModel batch receiver sends the batch on whole. 
+     regions that intercept messages in receiveMessage() should also 
+     intercept batches here. 
+   */
+  virtual void receiveMessages(MessageBatch msgs);
+
   /**
      Each region is prompted to do its beginning-of-time-step 
      stuff at the tick of the timer. 
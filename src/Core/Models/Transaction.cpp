@@ -166,6 +166,11 @@ void Transaction::setMinFrac(double new_minfrac) {
   minfrac_ = new_minfrac;
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int Transaction::transID() const {
+  return trans_id_;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ////////////// Output db recording code ///////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -150,6 +150,12 @@ class Transaction {
      */
     void setMinFrac(double new_minfrac);
 
+    /**
+       @return the ID given to this transaction and its match by 
+       matchWith()
+     */
+    int transID() const;
+
   private:
     /**
       The minimum fraction of the specified commodity that the 
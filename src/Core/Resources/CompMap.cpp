@@ -28,18 +28,19 @@ CompMap::~CompMap() {
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
-CompMap::iterator CompMap::begin() {
+CompMap::iterator CompMap::begin() const {
   return map_.begin();
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
-CompMap::iterator CompMap::end() {
+CompMap::iterator CompMap::end() const {
   return map_.end();
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 double& CompMap::operator[](const int& tope) {
   normalized_ = false;
+  invalidateOtherBasis();
   return map_.operator[](tope);
 }
 
@@ -51,13 +52,15 @@ int CompMap::count(Iso tope) const {
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 void CompMap::erase(Iso tope) {
   normalized_ = false;
+  invalidateOtherBasis();
   map_.erase(tope);
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 void CompMap::erase(CompMap::iterator position) {
   normalized_ = false;
-  map_.erase(position);
+  invalidateOtherBasis();
+  map_.erase(position->first);
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
@@ -114,26 +117,22 @@ int CompMap::ID() const {
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 double CompMap::massFraction(const Iso& tope) const {
-  if (count(tope) == 0) {
+  const Map& fractions = (basis_ == MASS) ? map_ : otherBasisMap();
+  Map::const_iterator it = fractions.find(tope);
+  if (it == fractions.end()) {
     return 0.0;
   }
-  double factor = 1.0;
-  if (basis_ != MASS) {
-    factor = MT->gramsPerMol(tope) / mass_to_atom_ratio_;
-  }
-  return factor * map_.find(tope)->second;
+  return it->second;
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 double CompMap::atomFraction(const Iso& tope) const {
-  if (count(tope) == 0) {
+  const Map& fractions = (basis_ == ATOM) ? map_ : otherBasisMap();
+  Map::const_iterator it = fractions.find(tope);
+  if (it == fractions.end()) {
     return 0.0;
   }
-  double factor = 1.0;
-  if (basis_ != ATOM) {
-    factor = 1 / (MT->gramsPerMol(tope) / mass_to_atom_ratio_);
-  }
-  return factor * map_.find(tope)->second;
+  return it->second;
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
@@ -224,6 +223,8 @@ void CompMap::init(Basis b) {
   ID_ = 0;
   decay_time_ = 0;
   parent_.reset();
+  other_basis_map_ = Map();
+  other_basis_cached_ = false;
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
@@ -232,27 +233,43 @@ void CompMap::change_basis(Basis b) {
     normalize();
   }
   if (basis_ != b) { // only change if we have to
-    for (iterator it = map_.begin(); it != map_.end(); it++) {
-      switch (b) {
-      case ATOM:
-        map_[it->first] = atomFraction(it->first);
-        break;
-      case MASS:
-        map_[it->first] = massFraction(it->first);
-        break;
-      default:
-        throw CycRangeException("Basis not atom or mass.");
-        break;
-      }
+    if (b != ATOM && b != MASS) {
+      throw CycRangeException("Basis not atom or mass.");
     }
+    otherBasisMap();
+    // the old map remains valid as the cache of the old basis
+    map_.swap(other_basis_map_);
     basis_ = b;
   }
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+const Map& CompMap::otherBasisMap() const {
+  if (!other_basis_cached_) {
+    other_basis_map_.clear();
+    for (const_iterator it = map_.begin(); it != map_.end(); it++) {
+      double factor = MT->gramsPerMol(it->first) / mass_to_atom_ratio_;
+      if (basis_ == MASS) {
+        factor = 1 / factor;
+      }
+      other_basis_map_.insert(other_basis_map_.end(),
+                              make_pair(it->first, factor * it->second));
+    }
+    other_basis_cached_ = true;
+  }
+  return other_basis_map_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+void CompMap::invalidateOtherBasis() {
+  other_basis_cached_ = false;
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 void CompMap::normalize(double sum) {
+  invalidateOtherBasis(); // the mass to atom ratio may have changed
   if (sum != 1) { // only normalize if needed
-    for (iterator it = map_.begin(); it != map_.end(); it++) {
+    for (Map::iterator it = map_.begin(); it != map_.end(); it++) {
       it->second /= sum;
     }
   }
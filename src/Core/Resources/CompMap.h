@@ -68,7 +68,7 @@ enum Basis {MASS, ATOM};
    
    * array index operator[](key)
 
-   * iterators: begin() and end()
+   * read-only iterators: begin() and end()
 
    * count(key)
    
@@ -92,6 +92,11 @@ enum Basis {MASS, ATOM};
    This ratio is the sum of all mass values divided by the sum of all
    atom values (mass value = atom value / grams-per-mol). This factor
    allows for quick access between the two bases.
+
+   The first query in the other basis builds a second map holding the
+   composition in that basis. It is kept until the composition is
+   altered, so later queries are plain lookups and changing the basis
+   simply swaps the two maps.
    
    @section Access
    The CompMap class offers, nominally, two ways to access atom
@@ -100,7 +105,9 @@ enum Basis {MASS, ATOM};
    atomFraction() methods. The latter will intelligently return a
    value corrected for a different basis (i.e., if the CompMap is in
    an atom-based state and a massFraction() call occurs, it will 
-   return the correct mass fraction).
+   return the correct mass fraction). Neither method changes the
+   basis, so they are safe to call on compositions shared by many
+   materials.
 
    @section Lineage & Decay
    The CompMap class provides functionality to track the lineage of
@@ -135,9 +142,10 @@ enum Basis {MASS, ATOM};
 class CompMap : public boost::enable_shared_from_this<CompMap> {  
  public:
   /**
-     masking Map
+     masking Map. the iterators are read-only, since the fractions in 
+     the other basis are cached; values are changed with operator[]
   */
-  typedef Map::iterator iterator;
+  typedef Map::const_iterator iterator;
   typedef Map::const_iterator const_iterator;
 
   /* --- Constructors and Destructors --- */
@@ -159,14 +167,14 @@ class CompMap : public boost::enable_shared_from_this<CompMap> {
   
   /* --- Instance Interaction --- */    
   /**
-     beginning iterator
+     beginning iterator, which is read-only
    */
-  CompMap::iterator begin();
+  CompMap::iterator begin() const;
 
   /**
-     ending iterator
+     ending iterator, which is read-only
    */
-  CompMap::iterator end();
+  CompMap::iterator end() const;
 
   /**
      accesses the subscript operator of the map
@@ -363,15 +371,39 @@ class CompMap : public boost::enable_shared_from_this<CompMap> {
    */
   CompMapPtr parent_;
 
+  /**
+     the composition expressed in the basis other than basis_, valid
+     only if other_basis_cached_ is true
+   */
+  mutable Map other_basis_map_;
+
+  /**
+     true if other_basis_map_ reflects the current map_
+   */
+  mutable bool other_basis_cached_;
+
   /**
      initializes all relevant members
   */
   void init(Basis b);
 
   /**
+     changes the basis of map_, swapping in the cached other basis map
+     @param b the new basis
    */
   void change_basis(Basis b);
 
+  /**
+     returns the composition in the basis other than basis_, building
+     and caching it if it is not already available
+   */
+  const Map& otherBasisMap() const;
+
+  /**
+     marks the cached other basis map as out of date
+   */
+  void invalidateOtherBasis();
+
   /**
      divides each entry in the map by a value labeled sum. it is assumed
      that sum is the total of all values in the map
@@ -216,19 +216,24 @@ void IsoVector::separate(const IsoVectorPtr& p_other, double efficiency) {
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 void IsoVector::decay(double time) {
   CompMapPtr parent = composition_;
+  DecayHandler handler;
+  if (handler.isStable(parent)) {
+    return; // nothing to decay
+  }
   CompMapPtr root = parent->root_comp();
   bool root_recorded = root->recorded();
   Basis orig_basis = parent->basis();
   CompMapPtr child;
   if (root_recorded) { 
+    // children are cached against their root recipe
     int t_f = parent->root_decay_time() + time;
-    bool child_recorded = RL->childRecorded(parent,t_f);
+    bool child_recorded = RL->childRecorded(root,t_f);
     if (child_recorded) {
-      child = RL->Child(parent,t_f);
+      child = RL->Child(root,t_f);
     }
     else {
       child = executeDecay(parent,time); // do decay and record it
-      RL->recordRecipeDecay(parent,child,t_f);
+      RL->recordRecipeDecay(root,child,t_f);
     }
   }
   else {
@@ -251,8 +256,7 @@ CompMapPtr IsoVector::executeDecay(CompMapPtr parent, double time) {
   double months_per_year = 12;
   double years = time / months_per_year;
   DecayHandler handler;
-  parent->atomify();
-  handler.setComp(parent); // handler will not change parent's map
+  handler.setComp(parent); // handler will not change parent's map or basis
   handler.decay(years);
   CompMapPtr child = handler.comp();
   child->parent_ = parent;
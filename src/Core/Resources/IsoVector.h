@@ -241,6 +241,11 @@ class IsoVector : public boost::enable_shared_from_this<IsoVector> {
      @return a pointer to the result of this decay
    */
   static CompMapPtr executeDecay(CompMapPtr parent, double time);
+
+  /**
+     the RecipeLibrary decays recipes ahead of the simulation
+   */
+  friend class RecipeLibrary;
   /* --- */
 };
 
@@ -2,6 +2,7 @@
 #include "Material.h"
 
 #include "CycException.h"
+#include "DecayHandler.h"
 #include "Timer.h"
 #include "Logger.h"
 
@@ -11,12 +12,14 @@
 using namespace std;
 using namespace boost;
 
-vector<mat_rsrc_ptr> Material::materials_;
+vector<Material*> Material::materials_;
 
 bool Material::decay_wanted_ = false;
 
 int Material::decay_interval_ = 1;
 
+bool Material::decay_lazy_ = false;
+
 table_ptr Material::material_table = table_ptr(new Table("MaterialHistory")); 
 
 bool Material::type_is_recorded_ = false;
@@ -24,12 +27,14 @@ bool Material::type_is_recorded_ = false;
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
 Material::Material() {
+  registerMaterial();
   last_update_time_ = TI->time();
   CLOG(LEV_INFO4) << "Material ID=" << ID_ << " was created.";
 };
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
 Material::Material(CompMapPtr comp) {
+  registerMaterial();
   IsoVector vec = IsoVector(comp);
   last_update_time_ = TI->time();
   iso_vector_ = vec;
@@ -38,6 +43,7 @@ Material::Material(CompMapPtr comp) {
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
 Material::Material(IsoVector vec) {
+  registerMaterial();
   last_update_time_ = TI->time();
   iso_vector_ = vec;
   CLOG(LEV_INFO4) << "Material ID=" << ID_ << " was created.";
@@ -45,16 +51,47 @@ Material::Material(IsoVector vec) {
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
 Material::Material(const Material& other) {
+  registerMaterial();
   iso_vector_ = other.iso_vector_;
   last_update_time_ = other.last_update_time_;
   quantity_ = other.quantity_;
   CLOG(LEV_INFO4) << "Material ID=" << ID_ << " was created.";
 };
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Material& Material::operator=(const Material& other) {
+  Resource::operator=(other);
+  iso_vector_ = other.iso_vector_;
+  last_update_time_ = other.last_update_time_;
+  // like a copy, this material keeps its own database history
+  return *this;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Material::~Material() {
+  unregisterMaterial();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Material::registerMaterial() {
+  registry_index_ = materials_.size();
+  materials_.push_back(this);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Material::unregisterMaterial() {
+  // moves the last material into this one's place to keep the list compact
+  Material* last = materials_.back();
+  materials_[registry_index_] = last;
+  last->registry_index_ = registry_index_;
+  materials_.pop_back();
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Material::absorb(mat_rsrc_ptr matToAdd) { 
   // @gidden figure out how to handle this with the database - mjg
   // Get the given Material's composition.
+  updateDecay();
   double amt = matToAdd->quantity();
   iso_vector_.mix(matToAdd->isoVector(),quantity_/amt); // @MJG_FLAG this looks like it copies isoVector()... should this return a pointer?
   quantity_ += amt;
@@ -71,6 +108,7 @@ mat_rsrc_ptr Material::extract(double mass) {
     err += ID_; 
     throw CycNegativeValueException(err);
   }
+  updateDecay();
   // remove our mass
   quantity_ -= mass;
   // make a new material, set its mass
@@ -87,20 +125,22 @@ mat_rsrc_ptr Material::extract(double mass) {
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 mat_rsrc_ptr Material::extract(const CompMapPtr comp_to_rem, double kg_to_rem) {
- 
+  updateDecay();
   CompMapPtr new_comp = CompMapPtr(this->unnormalizeComp(MASS));
   assert(!new_comp->normalized());
   CompMapPtr remove_comp = comp_to_rem;
-  remove_comp->massify();
-  assert(remove_comp->normalized());
-  double remainder_kg, new_kg, kg_to_rem_i;
+  if (!remove_comp->normalized()) {
+    remove_comp->normalize();
+  }
+  double remainder_kg, kg_to_rem_i;
+  double new_kg = 0;
   remainder_kg = this->quantity();
   int iso;
 
   for (CompMap::iterator it = remove_comp->begin(); 
        it != remove_comp->end(); it++) {
     // reduce isotope, if it exists in new_comp
-    kg_to_rem_i = it->second * kg_to_rem;
+    kg_to_rem_i = remove_comp->massFraction(it->first) * kg_to_rem;
     iso = it->first;
     if ( this->mass(iso) >= kg_to_rem_i ) {
       (*new_comp)[iso] = this->mass(iso) - kg_to_rem_i;
@@ -142,7 +182,7 @@ void Material::print() {
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
 string Material::detail() {
   vector<string>::iterator entry;
-  vector<string> entries = iso_vector_.comp()->compStrings();
+  vector<string> entries = isoVector().comp()->compStrings();
   for (entry = entries.begin(); entry != entries.end(); entry++) {
     CLOG(LEV_INFO5) << "   " << *entry;
   }
@@ -178,15 +218,8 @@ double Material::mass(Iso tope, MassUnit unit) {
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
 double Material::mass(Iso tope){
-  double to_ret;
-  CompMapPtr the_comp = isoVector().comp();
-  the_comp->massify();
-  if(the_comp->count(tope) != 0) {
-    to_ret = the_comp->massFraction(tope)*mass(KG);
-  } else {
-    to_ret = 0;
-  }
-  return to_ret;
+  // massFraction() leaves the (possibly shared) composition's basis alone
+  return isoVector().comp()->massFraction(tope)*mass(KG);
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
@@ -229,15 +262,8 @@ double Material::moles(){
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
 double Material::moles(Iso tope){
-  double to_ret;
-  CompMapPtr the_comp = isoVector().comp();
-  the_comp->atomify();
-  if(the_comp->count(tope) != 0) {
-    to_ret = moles()*isoVector().comp()->atomFraction(tope);
-  } else {
-    to_ret = 0;
-  }
-  return to_ret;
+  // atomFraction() leaves the (possibly shared) composition's basis alone
+  return moles()*isoVector().comp()->atomFraction(tope);
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
@@ -247,20 +273,20 @@ CompMapPtr Material::unnormalizeComp(Basis basis){
 
   switch(basis) {
     case MASS :
-      norm_comp->massify();
       scaling = this->mass(KG);
       break;
     case ATOM :
-      norm_comp->atomify();
       scaling = this->moles();
       break;
     default : 
       throw CycException("The basis provided is not a supported CompMap basis");
   }
-  CompMapPtr full_comp = CompMapPtr(new CompMap(*norm_comp));
+  CompMapPtr full_comp = CompMapPtr(new CompMap(basis));
   CompMap::iterator it;
   for( it=norm_comp->begin(); it!= norm_comp->end(); ++it ){
-    (*full_comp)[it->first] = scaling*(it->second);
+    double fraction = (basis == MASS) ? norm_comp->massFraction(it->first) :
+      norm_comp->atomFraction(it->first);
+    (*full_comp)[it->first] = scaling*fraction;
   }
 
   return full_comp;
@@ -298,24 +324,44 @@ bool Material::checkQuality(rsrc_ptr other){
 void Material::decay() {
   int curr_time = TI->time();
   int delta_time = curr_time - last_update_time_;
+  if (delta_time <= 0) {
+    return; // already up to date
+  }
   
   iso_vector_.decay((double)delta_time);
 
   last_update_time_ = curr_time;
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+IsoVector Material::isoVector() {
+  updateDecay();
+  return iso_vector_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Material::updateDecay() {
+  if (!decay_wanted_ || !decay_lazy_) {
+    return;
+  }
+  // the last time decayMaterials() would have decayed this material
+  int curr_time = TI->time();
+  int decay_time = curr_time - curr_time % decay_interval_;
+  if (decay_time > last_update_time_) {
+    iso_vector_.decay((double)(decay_time - last_update_time_));
+    last_update_time_ = decay_time;
+  }
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Material::decayMaterials(int time) {
-  // if decay is on
-  if (decay_wanted_) {
+  // if decay is on and materials are not decayed as they are observed
+  if (decay_wanted_ && !decay_lazy_) {
     // and if (time(mod interval)==0)
     if (time % decay_interval_ == 0) {
-      // acquire a list of all materials
-      for (vector<mat_rsrc_ptr>::iterator mat = materials_.begin();
-          mat != materials_.end();
-          mat++){
-         // and decay each of them
-         (*mat)->decay();
+      // decay each of the live materials
+      for (int i = 0; i < materials_.size(); i++) {
+        materials_[i]->decay();
       }
     }
   }
@@ -328,9 +374,31 @@ void Material::setDecay(int dec) {
   } else if ( dec > 0 ) {
     decay_wanted_ = true;
     decay_interval_ = dec;
+    // materials decay by whole months, so one month propagators cover them
+    DecayHandler::setPropagatorInterval(1.0 / 12.0);
   }
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Material::setLazyDecay(bool lazy) {
+  decay_lazy_ = lazy;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Material::lazyDecay() {
+  return decay_lazy_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int Material::nLiveMaterials() {
+  return materials_.size();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int Material::decayInterval() {
+  return decay_wanted_ ? decay_interval_ : 0;
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 bool Material::isMaterial(rsrc_ptr rsrc)
 {
@@ -340,6 +408,7 @@ bool Material::isMaterial(rsrc_ptr rsrc)
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Material::addToTable() {
+  updateDecay(); // the recorded state must be current
   Resource::addToTable();
   iso_vector_.record();
 }
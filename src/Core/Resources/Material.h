@@ -90,9 +90,18 @@ public:
   Material(const Material& other);
   
   /**
-     default destructor 
+     assigns the contents of another material object, keeping this 
+     one's place in the list of live materials and, like the copy 
+     constructor, its own database history 
+     @param other the material object to copy from 
+   */
+  Material& operator=(const Material& other);
+
+  /**
+     default destructor, which removes the material from the list of 
+     live materials 
    */
-  ~Material() {};
+  ~Material();
 
   /**
      standard verbose printer includes both an 
@@ -240,11 +249,12 @@ public:
   void decay();
 
   /**
-     Returns a copy of this material's isotopic composition 
+     Returns a copy of this material's isotopic composition, brought up 
+     to date first if decay is lazy 
 
      @return a copy of the isovector
    */
-  IsoVector isoVector() {return iso_vector_;}
+  IsoVector isoVector();
 
   /**
      Decays all of the materials if decay is on 
@@ -260,6 +270,32 @@ public:
    */
   static void setDecay(int dec);
 
+  /**
+     sets whether decay is lazy. in lazy mode decayMaterials() does 
+     nothing; instead each material is decayed, in a single step, when 
+     its composition is next observed. the result is the same as if it 
+     had been decayed at every decay interval in between. 
+
+     @param lazy true to turn lazy decay on (default = false) 
+   */
+  static void setLazyDecay(bool lazy);
+
+  /**
+     returns true if decay is lazy 
+   */
+  static bool lazyDecay();
+
+  /**
+     returns the number of months between decay calculations, or 0 if 
+     decay is off 
+   */
+  static int decayInterval();
+
+  /**
+     returns the number of materials currently alive in the simulation 
+   */
+  static int nLiveMaterials();
+
   /**
      returns true if the resource pointer points to a material resource
   */
@@ -276,6 +312,13 @@ protected:
   
 
 private:
+  /**
+     Decays this material up to the most recent decay interval if decay 
+     is lazy and it has not been decayed since. Called whenever the 
+     composition is observed. 
+   */
+  void updateDecay();
+
   /**
      This scales the composition by the amount of moles or kg, depending on the 
      basis provided. It returns an unnormalized CompMapPtr
@@ -299,9 +342,26 @@ private:
   IsoVector iso_vector_;
 
   /**
-     list of materials 
+     adds this material to the list of live materials 
+   */
+  void registerMaterial();
+
+  /**
+     removes this material from the list of live materials 
+   */
+  void unregisterMaterial();
+
+  /**
+     the position of this material in the list of live materials 
+   */
+  int registry_index_;
+
+  /**
+     list of live materials. materials add themselves on construction 
+     and remove themselves on destruction, so the list holds no 
+     references and never keeps a material alive. 
    */
-  static std::vector<mat_rsrc_ptr> materials_;
+  static std::vector<Material*> materials_;
 
   /**
      true if decay should occur, false if not. 
@@ -313,6 +373,11 @@ private:
    */
   static int decay_interval_;
 
+  /**
+     true if materials are decayed only when they are observed 
+   */
+  static bool decay_lazy_;
+
 // -------- resource class related members  -------- 
  public:
   /**
@@ -353,7 +418,7 @@ private:
   /**
      return the state id for the iso vector 
    */
-  virtual int stateID() {return iso_vector_.comp()->ID();}
+  virtual int stateID() {return isoVector().comp()->ID();}
 
  private:
   /**
@@ -0,0 +1,142 @@
+// BatemanSolver.cpp
+// Implements the BatemanSolver class
+#include "BatemanSolver.h"
+
+#include "CycException.h"
+
+#include <cmath>
+#include <queue>
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Vector BatemanSolver::solve(const Matrix & A, const Vector & x_o, double t) {
+  int n = A.numRows();
+
+  if ( x_o.numRows() != n ) {
+    string error = "Error: Matrix-Vector dimensions are not compatible.";
+    throw CycRangeException(error);
+  }
+
+  // a lower triangular matrix is already ordered parents first
+  bool triangular = isLowerTriangular(A);
+  vector<int> order;
+  if ( triangular ) {
+    for ( int i = 1; i <= n; ++i ) {
+      order.push_back(i);
+    }
+  } else {
+    order = parentsFirst(A);
+  }
+  vector<Coefficients> coeffs(n + 1);
+  vector<long double> sums(n + 1, 0);
+  vector<bool> is_ancestor(n + 1, false);
+  
+  // the solution for isotope i is sum_k c_ik * exp(-lambda_k * t), where
+  // c_ik = sum_j A(i,j) * c_jk / (lambda_i - lambda_k) over its parents j
+  // for each ancestor k, and c_ii makes the sum equal x_o(i) at t = 0
+  for ( int idx = 0; idx < n; ++idx ) {
+    int i = order.at(idx);
+    long double lambda_i = -A(i,i);
+    Coefficients& c_i = coeffs.at(i);
+    vector<int> ancestors;
+
+    // only the columns before i can hold parents of a triangular matrix
+    int last_parent = triangular ? i - 1 : n;
+    for ( int j = 1; j <= last_parent; ++j ) {
+      long double rate = A(i,j);
+      if ( j == i || rate == 0 ) {
+        continue;
+      }
+      Coefficients& c_j = coeffs.at(j);
+      for ( Coefficients::iterator it = c_j.begin(); it != c_j.end(); ++it ) {
+        int k = it->first;
+        long double lambda_k = -A(k,k);
+        long double diff = lambda_i - lambda_k;
+        if ( fabs(diff) <= 1e-12 * max(fabs(lambda_i), fabs(lambda_k)) ) {
+          stringstream error;
+          error << "Error: isotopes at positions " << i << " and " << k 
+                << " in a decay chain share a decay constant.";
+          error << "\nThe Bateman solution cannot solve the decay equation.";
+          throw CycRangeException(error.str());
+        }
+        if ( !is_ancestor.at(k) ) {
+          is_ancestor.at(k) = true;
+          ancestors.push_back(k);
+        }
+        sums.at(k) += rate * it->second / diff;
+      }
+    }
+
+    long double c_ii = x_o(i,1);
+    for ( vector<int>::iterator k = ancestors.begin(); 
+          k != ancestors.end(); ++k ) {
+      c_i.push_back(make_pair(*k, sums.at(*k)));
+      c_ii -= sums.at(*k);
+      sums.at(*k) = 0;
+      is_ancestor.at(*k) = false;
+    }
+    c_i.push_back(make_pair(i, c_ii));
+  }
+
+  // evaluates each exponential once and sums the terms
+  vector<long double> exps(n + 1);
+  for ( int k = 1; k <= n; ++k ) {
+    exps.at(k) = exp(A(k,k) * t);
+  }
+  Vector x_t(n,1);
+  for ( int i = 1; i <= n; ++i ) {
+    long double x_i = 0;
+    Coefficients& c_i = coeffs.at(i);
+    for ( Coefficients::iterator it = c_i.begin(); it != c_i.end(); ++it ) {
+      x_i += it->second * exps.at(it->first);
+    }
+    // cancellation can leave tiny negative amounts of depleted isotopes
+    x_t(i,1) = (x_i > 0) ? x_i : 0;
+  }
+
+  return x_t;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+vector<int> BatemanSolver::parentsFirst(const Matrix & A) {
+  int n = A.numRows();
+  vector<int> n_parents(n + 1, 0);
+  for ( int i = 1; i <= n; ++i ) {
+    for ( int j = 1; j <= n; ++j ) {
+      if ( j != i && A(i,j) != 0 ) {
+        ++n_parents.at(i);
+      }
+    }
+  }
+
+  queue<int> ready;
+  for ( int i = 1; i <= n; ++i ) {
+    if ( n_parents.at(i) == 0 ) {
+      ready.push(i);
+    }
+  }
+
+  vector<int> order;
+  while ( !ready.empty() ) {
+    int j = ready.front();
+    ready.pop();
+    order.push_back(j);
+    // releases the daughters of j
+    for ( int i = 1; i <= n; ++i ) {
+      if ( i != j && A(i,j) != 0 && --n_parents.at(i) == 0 ) {
+        ready.push(i);
+      }
+    }
+  }
+
+  if ( (int)order.size() != n ) {
+    string error = "Error: the decay matrix contains a cycle.";
+    error += "\nThe Bateman solution cannot solve the decay equation.";
+    throw CycRangeException(error);
+  }
+
+  return order;
+}
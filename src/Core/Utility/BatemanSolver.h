@@ -0,0 +1,63 @@
+// BatemanSolver.h
+#ifndef BATEMANSOLVER_H
+#define BATEMANSOLVER_H
+
+#include "UseMatrixLib.h"
+#include "DecaySolver.h"
+
+#include <vector>
+#include <utility>
+
+/**
+   @class BatemanSolver 
+    
+   A class that solves the decay equation in closed form using the
+   general solution of the Bateman equations. 
+
+   Decay chains without cycles are solved exactly: the amount of each 
+   isotope is a sum of exponentials exp(-lambda_k * t), one for itself 
+   and one for each of its ancestors. The coefficients of these terms 
+   are found by visiting the isotopes parents-first, so the cost grows 
+   with the number of ancestors of each isotope and not with the decay 
+   time. There is no series to truncate and no term can underflow the 
+   way the Uniform Taylor expansion does for long decay times. 
+
+   Parents need not be sorted first if the decay matrix is lower 
+   triangular, as the DecayHandler builds it. 
+
+   The closed form requires ancestors to have distinct decay constants; 
+   a CycRangeException is thrown if they do not or if the decay matrix 
+   contains a cycle. 
+ */
+class BatemanSolver : public DecaySolver {
+
+  public:
+    /**
+       Solves the decay equation dx/dt = A * x for x(t) = e^(tA) * x(t=0)
+        
+       @param A the decay Matrix 
+       @param x_o the initial condition Vector x(t=0) 
+       @param t the value for which the solution is being evaluated 
+       @return the solution Vector x(t) 
+       @throw CycRangeException if the Bateman solution does not apply
+     */
+    virtual Vector solve(const Matrix & A, const Vector & x_o, double t);
+
+  private:
+    /**
+       the coefficients of an isotope's solution, as pairs of the isotope 
+       whose decay constant the exponential term uses and its coefficient 
+     */
+    typedef std::vector< std::pair<int, long double> > Coefficients;
+
+    /**
+       Orders the isotopes so that every parent precedes its daughters. 
+        
+       @param A the decay Matrix 
+       @return the (1-based) rows of A, parents first 
+       @throw CycRangeException if the decay matrix contains a cycle 
+     */
+    static std::vector<int> parentsFirst(const Matrix & A);
+};
+
+#endif
@@ -6,6 +6,8 @@ using namespace std;
 using namespace SupplyDemand;
 using namespace ActionBuilding;
 
+int Builder::producer_revision_ = 0;
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 Builder::Builder() {}
 
@@ -21,6 +23,7 @@ void Builder::registerProducer(SupplyDemand::CommodityProducer* producer) {
   else
     {
       producers_.insert(producer);
+      producer_revision_++;
     }
 }
 
@@ -33,6 +36,7 @@ void Builder::unRegisterProducer(SupplyDemand::CommodityProducer* producer) {
   else
     {
       producers_.erase(producer);
+      producer_revision_++;
     }
 }
 
@@ -53,3 +57,9 @@ std::set<CommodityProducer*>::iterator Builder::endingProducer()
 {
   return producers_.end();
 }
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+int Builder::producerRevision()
+{
+  return producer_revision_;
+}
@@ -49,10 +49,19 @@ namespace ActionBuilding
      */
     std::set<SupplyDemand::CommodityProducer*>::iterator endingProducer();
 
+    /**
+       @return a count that changes whenever any builder registers or
+       unregisters a producer
+     */
+    static int producerRevision();
+
   private:
     /// the set of managed producers
     std::set<SupplyDemand::CommodityProducer*> producers_;
 
+    /// the number of producer registrations across all builders
+    static int producer_revision_;
+
     //#include "CommodityProducerManagerTests.h"
     //friend class CommodityProducerManagerTests; 
     // @MJGFlag - removed for the same reason as above
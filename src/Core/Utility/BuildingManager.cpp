@@ -6,6 +6,7 @@
 #include "Solver.h"
 #include "SolverInterface.h"
 #include "CBCSolver.h"
+#include "CoverSolver.h"
 #include "CycException.h"
 
 using namespace std;
@@ -34,6 +35,15 @@ ProblemInstance::ProblemInstance(Commodity& commod, double demand,
   solution(soln)
 {}
 
+// -------------------------------------------------------------------
+BuildSession::BuildSession() :
+  producer_revision(-1),
+  commodity_revision(-1),
+  decided(false),
+  demand(0),
+  production_revision(-1)
+{}
+
 // -------------------------------------------------------------------
 BuildingManager::BuildingManager() {}
 
@@ -49,6 +59,7 @@ void BuildingManager::registerBuilder(ActionBuilding::Builder* builder) {
   else
     {
       builders_.insert(builder);
+      sessions_.clear();
     }
 }
 
@@ -61,6 +72,7 @@ void BuildingManager::unRegisterBuilder(ActionBuilding::Builder* builder) {
   else
     {
       builders_.erase(builder);
+      sessions_.clear();
     }
 }
 
@@ -72,43 +84,26 @@ std::vector<ActionBuilding::BuildOrder> BuildingManager::makeBuildDecision(Commo
 
   if (unmet_demand > 0) 
     {
-      // set up solver and interface
-      SolverPtr solver(new CBCSolver());
-      SolverInterface csi(solver);
-
-      // set up objective function
-      ObjFuncPtr obj(new ObjectiveFunction(ObjectiveFunction::MIN));
-      csi.registerObjFunction(obj);
-
-      // set up constraint
-      ConstraintPtr constraint(new Constraint(Constraint::GTEQ,unmet_demand));
-      csi.registerConstraint(constraint);
-
-      // set up variables, constraints, and objective function
-      vector<VariablePtr> solution;
-      ProblemInstance problem(commodity,unmet_demand,csi,constraint,solution);
-      setUpProblem(problem);
-
-      // report problem
-      LOG(LEV_DEBUG2,"buildman") << "Building Manager is solving a decision problem with:";
-      LOG(LEV_DEBUG2,"buildman") << "  * Objective Function: " << obj->print();
-      LOG(LEV_DEBUG2,"buildman") << "  * Constraint: " << constraint->print();
-  
-      // solve
-      csi.solve();
+      // reuse the last decision if nothing it depended on has changed
+      BuildSession& cached = session(commodity);
+      if (cached.decided && cached.demand == unmet_demand &&
+          cached.production_revision == CommodityProducer::productionRevision())
+        {
+          LOG(LEV_DEBUG2,"buildman") << "Building Manager is reusing its last decision for "
+                                     << commodity.name();
+          return cached.orders;
+        }
 
-      // report solution
-      LOG(LEV_DEBUG2,"buildman") << "Building Manager has solved a decision problem with:";
-      LOG(LEV_DEBUG2,"buildman") << "  * Types of Prototypes to build: " << solution.size();
-      for (int i = 0; i < solution.size(); i++)
+      // the exact cover solver answers most decisions without CBC
+      if (!solveCoverProblem(cached,commodity,unmet_demand,orders))
         {
-          VariablePtr x = solution.at(i);
-          LOG(LEV_DEBUG2,"buildman") << "  * Type: " << x->name()
-                                     << "  * Value: " << any_cast<int>(x->value());
+          solveWithCBC(commodity,unmet_demand,orders);
         }
-  
-      // construct order
-      constructBuildOrdersFromSolution(orders,solution);
+
+      cached.decided = true;
+      cached.demand = unmet_demand;
+      cached.production_revision = CommodityProducer::productionRevision();
+      cached.orders = orders;
     }
 
   return orders;
@@ -119,20 +114,12 @@ void BuildingManager::setUpProblem(ActionBuilding::ProblemInstance& problem)
 {
   solution_map_ = map< VariablePtr, pair<Builder*,CommodityProducer*> >();
 
-  set<Builder*>::iterator builder_it;
-  for (builder_it = builders_.begin(); builder_it != builders_.end(); builder_it++)
+  BuildSession& cached = session(problem.commodity);
+  for (int i = 0; i < cached.candidates.size(); i++)
     {
-      Builder* builder = (*builder_it);
-      
-      set<CommodityProducer*>::iterator producer_it;
-      for (producer_it = builder->beginningProducer(); producer_it != builder->endingProducer(); producer_it++)
-        {
-          CommodityProducer* producer = (*producer_it);
-          if (producer->producesCommodity(problem.commodity))
-            {
-              addProducerVariableToProblem(producer,builder,problem);
-            }
-        }
+      addProducerVariableToProblem(cached.candidates.at(i).second,
+                                   cached.candidates.at(i).first,
+                                   problem);
     }
 }
 
@@ -170,3 +157,117 @@ void BuildingManager::constructBuildOrdersFromSolution(std::vector<ActionBuildin
         }
     }
 }
+
+// -------------------------------------------------------------------
+ActionBuilding::BuildSession& BuildingManager::session(const Commodity& commodity)
+{
+  BuildSession& cached = sessions_[commodity.name()];
+  if (cached.producer_revision == Builder::producerRevision() &&
+      cached.commodity_revision == CommodityProducer::commodityRevision())
+    {
+      return cached;
+    }
+
+  cached = BuildSession();
+  set<Builder*>::iterator builder_it;
+  for (builder_it = builders_.begin(); builder_it != builders_.end(); builder_it++)
+    {
+      Builder* builder = (*builder_it);
+      
+      set<CommodityProducer*>::iterator producer_it;
+      for (producer_it = builder->beginningProducer(); producer_it != builder->endingProducer(); producer_it++)
+        {
+          CommodityProducer* producer = (*producer_it);
+          if (producer->producesCommodity(commodity))
+            {
+              cached.candidates.push_back(make_pair(builder,producer));
+            }
+        }
+    }
+  cached.producer_revision = Builder::producerRevision();
+  cached.commodity_revision = CommodityProducer::commodityRevision();
+  return cached;
+}
+
+// -------------------------------------------------------------------
+bool BuildingManager::solveCoverProblem(ActionBuilding::BuildSession& session,
+                                        Commodity& commodity, 
+                                        double unmet_demand,
+                                        std::vector<ActionBuilding::BuildOrder>& orders)
+{
+  vector<double> capacities, costs;
+  for (int i = 0; i < session.candidates.size(); i++)
+    {
+      CommodityProducer* producer = session.candidates.at(i).second;
+      capacities.push_back(producer->productionCapacity(commodity));
+      costs.push_back(producer->productionCost(commodity));
+    }
+
+  vector<int> numbers;
+  CoverSolver solver;
+  if (!solver.solve(capacities,costs,unmet_demand,numbers))
+    {
+      LOG(LEV_DEBUG2,"buildman") << "Building Manager is leaving a decision problem to CBC after "
+                                 << solver.nNodes() << " branches";
+      return false;
+    }
+
+  LOG(LEV_DEBUG2,"buildman") << "Building Manager has solved a decision problem in "
+                             << solver.nNodes() << " branches with:";
+  for (int i = 0; i < numbers.size(); i++)
+    {
+      LOG(LEV_DEBUG2,"buildman") << "  * Type: " << i
+                                 << "  * Value: " << numbers.at(i);
+      if (numbers.at(i) > 0)
+        {
+          BuildOrder order(numbers.at(i),session.candidates.at(i).first,
+                           session.candidates.at(i).second);
+          orders.push_back(order);
+        }
+    }
+  return true;
+}
+
+// -------------------------------------------------------------------
+void BuildingManager::solveWithCBC(Commodity& commodity, 
+                                   double unmet_demand,
+                                   std::vector<ActionBuilding::BuildOrder>& orders)
+{
+  // set up solver and interface
+  SolverPtr solver(new CBCSolver());
+  SolverInterface csi(solver);
+
+  // set up objective function
+  ObjFuncPtr obj(new ObjectiveFunction(ObjectiveFunction::MIN));
+  csi.registerObjFunction(obj);
+
+  // set up constraint
+  ConstraintPtr constraint(new Constraint(Constraint::GTEQ,unmet_demand));
+  csi.registerConstraint(constraint);
+
+  // set up variables, constraints, and objective function
+  vector<VariablePtr> solution;
+  ProblemInstance problem(commodity,unmet_demand,csi,constraint,solution);
+  setUpProblem(problem);
+
+  // report problem
+  LOG(LEV_DEBUG2,"buildman") << "Building Manager is solving a decision problem with:";
+  LOG(LEV_DEBUG2,"buildman") << "  * Objective Function: " << obj->print();
+  LOG(LEV_DEBUG2,"buildman") << "  * Constraint: " << constraint->print();
+  
+  // solve
+  csi.solve();
+
+  // report solution
+  LOG(LEV_DEBUG2,"buildman") << "Building Manager has solved a decision problem with:";
+  LOG(LEV_DEBUG2,"buildman") << "  * Types of Prototypes to build: " << solution.size();
+  for (int i = 0; i < solution.size(); i++)
+    {
+      VariablePtr x = solution.at(i);
+      LOG(LEV_DEBUG2,"buildman") << "  * Type: " << x->name()
+                                 << "  * Value: " << any_cast<int>(x->value());
+    }
+  
+  // construct order
+  constructBuildOrdersFromSolution(orders,solution);
+}
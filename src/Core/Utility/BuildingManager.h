@@ -38,6 +38,29 @@ namespace ActionBuilding {
     Cyclopts::ConstraintPtr constraint;
     std::vector<Cyclopts::VariablePtr>& solution;
   };
+
+  /// a struct for the decision problem kept for a commodity between calls
+  struct BuildSession
+  {
+    /// constructor
+    BuildSession();
+
+    /// the builder and producer revisions the candidates were found at
+    int producer_revision;
+    int commodity_revision;
+
+    /// the builders and producers able to meet the commodity's demand
+    std::vector< std::pair<ActionBuilding::Builder*,
+      SupplyDemand::CommodityProducer*> > candidates;
+
+    /// whether orders have been decided, and for what demand and costs
+    bool decided;
+    double demand;
+    int production_revision;
+
+    /// the orders last decided
+    std::vector<ActionBuilding::BuildOrder> orders;
+  };
  
   /**
      The BuildingManager class is a managing entity that makes decisions
@@ -59,6 +82,17 @@ namespace ActionBuilding {
      cost to build the object of type i, \f$\phi_i\f$ is the nameplate 
      capacity of the object, and \f$\Phi\f$ is the capacity demand. Here
      the set I corresponds to all producers of a given commodity.
+
+     The manager keeps a session for each commodity it has been asked
+     about, holding the producers of that commodity and the last
+     decision made. Walking the builders to find the producers is only
+     repeated once a builder or producer has changed, and a decision
+     for the same demand with unchanged capacities and costs reuses the
+     last orders instead of solving the program again.
+
+     Since the program has a single constraint, it is solved exactly by
+     a CoverSolver, and only left to CBC if the CoverSolver can not 
+     answer it.
   */
   class BuildingManager 
   {
@@ -123,7 +157,39 @@ namespace ActionBuilding {
      */
     void constructBuildOrdersFromSolution(std::vector<BuildOrder>& orders,
                                           std::vector<Cyclopts::VariablePtr>& solution);
+
+    /**
+       the session for a commodity, with its candidates found again if
+       any builder or producer has changed since they were last found
+       @param commodity the commodity in question
+     */
+    ActionBuilding::BuildSession& session(const Commodity& commodity);
+
   private:
+    /**
+       solve the decision problem for a session with a CoverSolver
+       @param session the session of the commodity
+       @param commodity the commodity being demanded
+       @param unmet_demand the additional capacity required
+       @param orders the set of orders to fill
+       @return false if the problem must be solved by CBC instead
+     */
+    bool solveCoverProblem(ActionBuilding::BuildSession& session,
+                           Commodity& commodity, double unmet_demand,
+                           std::vector<ActionBuilding::BuildOrder>& orders);
+
+    /**
+       solve the decision problem with CBC
+       @param commodity the commodity being demanded
+       @param unmet_demand the additional capacity required
+       @param orders the set of orders to fill
+     */
+    void solveWithCBC(Commodity& commodity, double unmet_demand,
+                      std::vector<ActionBuilding::BuildOrder>& orders);
+
+    /// the session for each commodity, by name
+    std::map<std::string,ActionBuilding::BuildSession> sessions_;
+
     /// the set of registered builders
     std::set<Builder*> builders_;
     
@@ -1,5 +1,6 @@
 #include "CommodityProducer.h"
 
+#include "CommodityProducerManager.h"
 #include "CycException.h"
 
 #include "CycloptsLimits.h"
@@ -7,6 +8,9 @@
 using namespace std;
 using namespace SupplyDemand;
 
+int CommodityProducer::commodity_revision_ = 0;
+int CommodityProducer::production_revision_ = 0;
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 CommodityInformation::CommodityInformation() :
   capacity(0),
@@ -27,7 +31,48 @@ CommodityProducer::CommodityProducer() :
 {}
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
-CommodityProducer::~CommodityProducer() {}
+CommodityProducer::CommodityProducer(const CommodityProducer& other) :
+  default_capacity_(other.default_capacity_),
+  default_cost_(other.default_cost_),
+  produced_commodities_(other.produced_commodities_)
+{}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+CommodityProducer::~CommodityProducer() 
+{
+  set<CommodityProducerManager*> managers = managers_;
+  set<CommodityProducerManager*>::iterator it;
+  for (it = managers.begin(); it != managers.end(); it++)
+    {
+      (*it)->unRegisterProducer(this);
+    }
+  commodity_revision_++;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+CommodityProducer& CommodityProducer::operator=(const CommodityProducer& other)
+{
+  if (this != &other)
+    {
+      // re-register so that each manager's totals see the new capacities
+      set<CommodityProducerManager*> managers = managers_;
+      set<CommodityProducerManager*>::iterator it;
+      for (it = managers.begin(); it != managers.end(); it++)
+        {
+          (*it)->unRegisterProducer(this);
+        }
+      default_capacity_ = other.default_capacity_;
+      default_cost_ = other.default_cost_;
+      produced_commodities_ = other.produced_commodities_;
+      for (it = managers.begin(); it != managers.end(); it++)
+        {
+          (*it)->registerProducer(this);
+        }
+      commodity_revision_++;
+      production_revision_++;
+    }
+  return *this;
+}
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 std::set<Commodity,CommodityCompare> CommodityProducer::producedCommodities()
@@ -64,6 +109,18 @@ double CommodityProducer::productionCost(const Commodity& commodity)
   return produced_commodities_[commodity].cost;
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+int CommodityProducer::commodityRevision()
+{
+  return commodity_revision_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+int CommodityProducer::productionRevision()
+{
+  return production_revision_;
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 void CommodityProducer::addCommodity(const Commodity& commodity) {
   CommodityInformation info(default_capacity_,default_cost_);
@@ -75,7 +132,15 @@ void CommodityProducer::setCapacity(const Commodity& commodity,
                                     double capacity)
 {
   throwErrorIfCommodityNotProduced(commodity);
+  double change = capacity - produced_commodities_[commodity].capacity;
   produced_commodities_[commodity].capacity = capacity;
+  production_revision_++;
+
+  set<CommodityProducerManager*>::iterator it;
+  for (it = managers_.begin(); it != managers_.end(); it++)
+    {
+      (*it)->updateTotal(commodity,change,0);
+    }
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
@@ -84,6 +149,7 @@ void CommodityProducer::setCost(const Commodity& commodity,
 {
   throwErrorIfCommodityNotProduced(commodity);
   produced_commodities_[commodity].cost = cost;
+  production_revision_++;
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
@@ -96,6 +162,13 @@ void CommodityProducer::addCommodityWithInformation(const Commodity& commodity,
                                            + commodity.name());
     }
   produced_commodities_.insert(make_pair(commodity,info));
+  commodity_revision_++;
+
+  set<CommodityProducerManager*>::iterator it;
+  for (it = managers_.begin(); it != managers_.end(); it++)
+    {
+      (*it)->updateTotal(commodity,info.capacity,1);
+    }
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
@@ -8,6 +8,8 @@
 
 namespace SupplyDemand
 {
+  class CommodityProducerManager;
+
   /**
      a container to hold information about a commodity
    */
@@ -28,9 +30,16 @@ namespace SupplyDemand
     /// constructor
     CommodityProducer();
 
-    /// virtual destructor for inheritence
+    /// copy constructor, which does not copy manager registrations
+    CommodityProducer(const CommodityProducer& other);
+
+    /// virtual destructor for inheritence, which unregisters the
+    /// producer from its managers
     virtual ~CommodityProducer();
 
+    /// assignment, which updates the totals of the producer's managers
+    CommodityProducer& operator=(const CommodityProducer& other);
+
     /**
        @return the set of commodities produced by this producers
      */
@@ -54,6 +63,18 @@ namespace SupplyDemand
      */
     double productionCost(const Commodity& commodity);
 
+    /**
+       @return a count that changes whenever any producer adds a 
+       commodity or is destroyed
+     */
+    static int commodityRevision();
+
+    /**
+       @return a count that changes whenever any producer's capacity
+       or cost changes
+     */
+    static int productionRevision();
+
     // protected: @MJGFlag - should be protected. revise when tests can
     // be found by classes in the Utility folder
     /**
@@ -107,6 +128,17 @@ namespace SupplyDemand
     /// a collection of commodities and their production capacities
     std::map<Commodity,CommodityInformation,CommodityCompare> produced_commodities_;
 
+    /// the number of commodity additions and producer deletions
+    static int commodity_revision_;
+
+    /// the number of capacity and cost changes
+    static int production_revision_;
+
+    /// the managers this producer is registered with
+    std::set<CommodityProducerManager*> managers_;
+
+    friend class CommodityProducerManager;
+
     //#include "CommodityProducerTests.h"
     //friend class CommodityProducerTests; 
     // @MJGFlag - removed for the same reason as above
@@ -9,21 +9,25 @@ using namespace SupplyDemand;
 CommodityProducerManager::CommodityProducerManager() {}
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
-CommodityProducerManager::~CommodityProducerManager() {}
+CommodityProducerManager::~CommodityProducerManager() 
+{
+  set<CommodityProducer*>::iterator it;
+  for (it = producers_.begin(); it != producers_.end(); it++)
+    {
+      (*it)->managers_.erase(this);
+    }
+}
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 double CommodityProducerManager::totalProductionCapacity(Commodity& commodity)
 {
-  double total = 0.0;
-  set<CommodityProducer*>::iterator it;
-  for (it = producers_.begin(); it != producers_.end(); it++)
+  map<Commodity,ProductionTotal,CommodityCompare>::iterator it = 
+    totals_.find(commodity);
+  if (it == totals_.end())
     {
-      if ( (*it)->producesCommodity(commodity) )
-        {
-          total += (*it)->productionCapacity(commodity);
-        }
+      return 0.0;
     }
-  return total;
+  return it->second.capacity;
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
@@ -35,6 +39,14 @@ void CommodityProducerManager::registerProducer(SupplyDemand::CommodityProducer*
   else
     {
       producers_.insert(producer);
+      producer->managers_.insert(this);
+      map<Commodity,CommodityInformation,CommodityCompare>::iterator it;
+      for (it = producer->produced_commodities_.begin(); 
+           it != producer->produced_commodities_.end(); 
+           it++)
+        {
+          updateTotal(it->first,it->second.capacity,1);
+        }
     }
 }
 
@@ -47,5 +59,27 @@ void CommodityProducerManager::unRegisterProducer(SupplyDemand::CommodityProduce
   else
     {
       producers_.erase(producer);
+      producer->managers_.erase(this);
+      map<Commodity,CommodityInformation,CommodityCompare>::iterator it;
+      for (it = producer->produced_commodities_.begin(); 
+           it != producer->produced_commodities_.end(); 
+           it++)
+        {
+          updateTotal(it->first,-it->second.capacity,-1);
+        }
+    }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+void CommodityProducerManager::updateTotal(const Commodity& commodity, 
+                                           double capacity, 
+                                           int producers)
+{
+  ProductionTotal& total = totals_[commodity];
+  total.producers += producers;
+  total.capacity += capacity;
+  if (total.producers <= 0)
+    {
+      totals_.erase(commodity);
     }
 }
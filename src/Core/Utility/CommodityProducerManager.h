@@ -1,6 +1,7 @@
 #ifndef COMMODITYPRODUCERMANAGER_H
 #define COMMODITYPRODUCERMANAGER_H
 
+#include <map>
 #include <set>
 
 #include "Commodity.h"
@@ -10,6 +11,11 @@ namespace SupplyDemand
 {
   /**
      a mixin to provide information about commodity producers
+
+     the total capacity of each commodity is kept up to date as 
+     producers are registered and unregistered and as registered 
+     producers add commodities or change their capacities, so that 
+     it may be looked up rather than summed over the producers
    */
   class CommodityProducerManager
   {
@@ -43,6 +49,30 @@ namespace SupplyDemand
     /// the set of managed producers
     std::set<CommodityProducer*> producers_;
 
+  private:
+    /// the number of producers of a commodity and their total capacity
+    struct ProductionTotal
+    {
+      ProductionTotal() : producers(0), capacity(0) {}
+      int producers;
+      double capacity;
+    };
+
+    /**
+       change the total for a commodity, dropping it once no producers
+       of the commodity are left so that no rounding error remains
+       @param commodity the commodity in question
+       @param capacity the change in capacity
+       @param producers the change in the number of producers
+     */
+    void updateTotal(const Commodity& commodity, double capacity, 
+                     int producers);
+
+    /// the total for each commodity amongst producers
+    std::map<Commodity,ProductionTotal,CommodityCompare> totals_;
+
+    friend class CommodityProducer;
+
     //#include "CommodityProducerManagerTests.h"
     //friend class CommodityProducerManagerTests; 
     // @MJGFlag - removed for the same reason as above
@@ -0,0 +1,150 @@
+#include "CoverSolver.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "CycLimits.h"
+
+using namespace std;
+using namespace ActionBuilding;
+
+namespace {
+  /// orders types by cost per capacity, then by the larger capacity
+  struct CheaperPerCapacity 
+  {
+    CheaperPerCapacity(const vector<double>& ratios, 
+                       const vector<double>& capacities) :
+      ratios_(ratios),
+      capacities_(capacities)
+    {}
+
+    bool operator()(int lhs, int rhs) const 
+    {
+      if (ratios_[lhs] != ratios_[rhs]) 
+        {
+          return ratios_[lhs] < ratios_[rhs];
+        }
+      if (capacities_[lhs] != capacities_[rhs]) 
+        {
+          return capacities_[lhs] > capacities_[rhs];
+        }
+      return lhs < rhs;
+    }
+
+    const vector<double>& ratios_;
+    const vector<double>& capacities_;
+  };
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+CoverSolver::CoverSolver(int max_nodes) :
+  max_nodes_(max_nodes),
+  n_nodes_(0),
+  best_cost_(0),
+  found_(false)
+{}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+bool CoverSolver::solve(const std::vector<double>& capacities,
+                        const std::vector<double>& costs,
+                        double demand, std::vector<int>& numbers) 
+{
+  int n = capacities.size();
+  capacities_ = capacities;
+  costs_ = costs;
+  ratios_ = vector<double>(n,0);
+  order_.clear();
+  n_nodes_ = 0;
+  found_ = false;
+
+  for (int i = 0; i < n; i++) 
+    {
+      if (costs_[i] < 0) 
+        {
+          return false;
+        }
+      // a type without capacity is never worth building
+      if (capacities_[i] > 0) 
+        {
+          ratios_[i] = costs_[i] / capacities_[i];
+          order_.push_back(i);
+        }
+    }
+  sort(order_.begin(),order_.end(),CheaperPerCapacity(ratios_,capacities_));
+
+  current_ = vector<int>(n,0);
+  best_ = current_;
+  branch(0,demand,0);
+  if (!found_ || n_nodes_ > max_nodes_) 
+    {
+      return false;
+    }
+
+  numbers = best_;
+  return true;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+int CoverSolver::nNodes() const 
+{
+  return n_nodes_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+void CoverSolver::branch(int position, double remaining, double cost) 
+{
+  if (++n_nodes_ > max_nodes_) 
+    {
+      return;
+    }
+
+  if (remaining <= cyclus::eps()) 
+    {
+      if (!found_ || cost < best_cost_ - cyclus::eps() * max(1.0,fabs(best_cost_))) 
+        {
+          best_ = current_;
+          best_cost_ = cost;
+          found_ = true;
+        }
+      return;
+    }
+  if (position == order_.size()) 
+    {
+      return;
+    }
+
+  int type = order_[position];
+  double most = ceil((remaining - cyclus::eps()) / capacities_[type]);
+  if (most > max_nodes_) 
+    {
+      n_nodes_ = max_nodes_ + 1;
+      return;
+    }
+
+  // building fewer of this type only raises the bound of the branches
+  // after it, since the types after it cost as much or more per capacity
+  for (int number = static_cast<int>(most); number >= 0; number--) 
+    {
+      double left = remaining - number * capacities_[type];
+      double spent = cost + number * costs_[type];
+      if (left > cyclus::eps()) 
+        {
+          if (position + 1 == order_.size()) 
+            {
+              break;
+            }
+          double bound = spent + left * ratios_[order_[position + 1]];
+          if (found_ && bound >= best_cost_ - cyclus::eps() * max(1.0,fabs(best_cost_))) 
+            {
+              break;
+            }
+        }
+      current_[type] = number;
+      branch(position + 1,left,spent);
+      current_[type] = 0;
+      if (n_nodes_ > max_nodes_) 
+        {
+          return;
+        }
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef COVERSOLVER_H
+#define COVERSOLVER_H
+
+#include <vector>
+
+namespace ActionBuilding 
+{
+  /**
+     An exact solver for the integer program the BuildingManager makes
+     its build decisions with, a covering problem with one constraint:
+
+     \f[
+     \min \sum_{i=1}^{N}n_i*c_i \\
+     s.t. \sum_{i=1}^{N}n_i*\phi_i \ge \Phi \\
+     n_i \in [0,\infty) \forall i \in I, n_i integer
+     \f]
+
+     The types are sorted by their cost per unit capacity and searched
+     depth first, building as many of the cheapest type as could be
+     needed before trying fewer. A branch is cut once the cost of
+     meeting its remaining demand at the best remaining cost per unit
+     capacity could not improve on the best solution found, which for
+     the handful of prototypes a commodity has leaves only a few
+     branches to visit, far fewer than a general MILP solver needs to
+     set up.
+
+     Problems the solver can not answer exactly are left to a general
+     solver: those with a negative cost, those whose demand can not be
+     met, and those needing more than a set number of branches.
+   */
+  class CoverSolver 
+  {
+  public:
+    /**
+       constructor
+       @param max_nodes the number of branches after which to give up
+     */
+    CoverSolver(int max_nodes = 100000);
+
+    /**
+       solve a covering problem
+       @param capacities the capacity of each type, phi_i
+       @param costs the cost of each type, c_i
+       @param demand the capacity demanded, Phi
+       @param numbers filled with the number of each type to build, n_i
+       @return true if the problem was solved, false if it must be left 
+       to a general solver
+     */
+    bool solve(const std::vector<double>& capacities,
+               const std::vector<double>& costs,
+               double demand, std::vector<int>& numbers);
+
+    /**
+       @return the number of branches visited by the last solve
+     */
+    int nNodes() const;
+
+  private:
+    /**
+       visit the branches building each number of the type at a sorted 
+       position, then those of the types after it
+       @param position the position of the type in the sorted order
+       @param remaining the demand left to meet
+       @param cost the cost of the types built so far
+     */
+    void branch(int position, double remaining, double cost);
+
+    /// the number of branches after which to give up
+    int max_nodes_;
+
+    /// the number of branches visited so far
+    int n_nodes_;
+
+    /// the types with a positive capacity, cheapest per capacity first
+    std::vector<int> order_;
+
+    /// the capacity, cost and cost per capacity of each type
+    std::vector<double> capacities_, costs_, ratios_;
+
+    /// the numbers built on the current branch and in the best solution
+    std::vector<int> current_, best_;
+
+    /// the cost of the best solution, and whether one has been found
+    double best_cost_;
+    bool found_;
+  };
+}
+
+#endif
@@ -0,0 +1,158 @@
+// CramSolver.cpp
+// Implements the CramSolver class
+#include "CramSolver.h"
+
+#include "CycException.h"
+
+#include <cmath>
+#include <string>
+
+using namespace std;
+
+namespace {
+  /// the order of the approximation is twice the number of poles used
+  const int n_poles = 8;
+
+  /// the real and imaginary parts of the residues of the IPF form
+  const long double alpha_re[n_poles] = {
+    +5.464930576870210e+3L, +9.045112476907548e+1L, +2.344818070467641e+2L,
+    +9.453304067358312e+1L, +7.283792954673409e+2L, +3.648229059594851e+1L,
+    +2.547321630156819e+1L, +2.394538338734709e+1L};
+  const long double alpha_im[n_poles] = {
+    -3.797983575308356e+4L, -1.115537522430261e+3L, -4.228020157070496e+2L,
+    -2.951294291446048e+2L, -1.205646080220011e+5L, -1.155509621409682e+2L,
+    -2.639500283021502e+1L, -5.650522971778156e+0L};
+
+  /// the real and imaginary parts of the poles of the IPF form
+  const long double theta_re[n_poles] = {
+    +3.509103608414918L, +5.948152268951177L, -5.264971343442647L,
+    +1.419375897185666L, +6.416177699099435L, +4.993174737717997L,
+    -1.413928462488886L, -1.084391707869699e+1L};
+  const long double theta_im[n_poles] = {
+    +8.436198985884374L, +3.587457362018322L, +1.622022147316793e+1L,
+    +1.092536348449672e+1L, +1.194122393370139L, +5.996881713603942L,
+    +1.349772569889275e+1L, +1.927744616718165e+1L};
+
+  /// the limit of the approximation at infinity
+  const long double alpha_0 = 2.124853710495224e-16L;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Vector CramSolver::solve(const Matrix & A, const Vector & x_o, double t) {
+  int n = A.numRows();
+
+  if ( x_o.numRows() != n ) {
+    string error = "Error: Matrix-Vector dimensions are not compatible.";
+    throw CycRangeException(error);
+  }
+
+  vector<long double> y(n);
+  for ( int i = 0; i < n; ++i ) {
+    y[i] = x_o(i+1,1);
+  }
+
+  // a triangular system is solved directly over its nonzero entries
+  bool triangular = isLowerTriangular(A);
+  SparseRows below(n);
+  if ( triangular ) {
+    for ( int i = 0; i < n; ++i ) {
+      for ( int j = 0; j < i; ++j ) {
+        if ( A(i+1,j+1) != 0 ) {
+          below[i].push_back(make_pair(j, t * A(i+1,j+1)));
+        }
+      }
+    }
+  }
+
+  // y_j = y_j-1 + 2 * Re( alpha_j * (t*A - theta_j*I)^-1 * y_j-1 )
+  for ( int j = 0; j < n_poles; ++j ) {
+    Complex alpha(alpha_re[j], alpha_im[j]);
+    Complex theta(theta_re[j], theta_im[j]);
+    vector<Complex> w = triangular ? forwardSolve(A, below, t, theta, y) :
+      shiftedSolve(A, t, theta, y);
+    for ( int i = 0; i < n; ++i ) {
+      y[i] += 2 * real(alpha * w[i]);
+    }
+  }
+
+  Vector x_t(n,1);
+  for ( int i = 0; i < n; ++i ) {
+    // the approximation error can leave tiny negative amounts
+    long double x_i = alpha_0 * y[i];
+    x_t(i+1,1) = (x_i > 0) ? x_i : 0;
+  }
+
+  return x_t;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+vector<CramSolver::Complex> CramSolver::shiftedSolve(const Matrix & A, 
+    double t, Complex theta, const vector<long double> & b) {
+  int n = A.numRows();
+
+  // builds the augmented system [t*A - theta*I | b]
+  vector< vector<Complex> > M(n, vector<Complex>(n + 1));
+  for ( int i = 0; i < n; ++i ) {
+    for ( int j = 0; j < n; ++j ) {
+      M[i][j] = t * A(i+1,j+1);
+    }
+    M[i][i] -= theta;
+    M[i][n] = b[i];
+  }
+
+  // forward elimination
+  for ( int k = 0; k < n; ++k ) {
+    int pivot = k;
+    for ( int i = k + 1; i < n; ++i ) {
+      if ( abs(M[i][k]) > abs(M[pivot][k]) ) {
+        pivot = i;
+      }
+    }
+    if ( abs(M[pivot][k]) == 0 ) {
+      string error = "Error: the shifted decay matrix is singular.";
+      throw CycRangeException(error);
+    }
+    M[k].swap(M[pivot]);
+    for ( int i = k + 1; i < n; ++i ) {
+      if ( M[i][k] == Complex(0) ) {
+        continue;
+      }
+      Complex factor = M[i][k] / M[k][k];
+      for ( int j = k; j <= n; ++j ) {
+        M[i][j] -= factor * M[k][j];
+      }
+    }
+  }
+
+  // back substitution
+  vector<Complex> x(n);
+  for ( int i = n - 1; i >= 0; --i ) {
+    Complex sum = M[i][n];
+    for ( int j = i + 1; j < n; ++j ) {
+      if ( M[i][j] != Complex(0) ) {
+        sum -= M[i][j] * x[j];
+      }
+    }
+    x[i] = sum / M[i][i];
+  }
+
+  return x;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+vector<CramSolver::Complex> CramSolver::forwardSolve(const Matrix & A, 
+    const SparseRows & below, double t, Complex theta, 
+    const vector<long double> & b) {
+  int n = A.numRows();
+  vector<Complex> x(n);
+  for ( int i = 0; i < n; ++i ) {
+    Complex sum = b[i];
+    const vector< pair<int, long double> >& row = below[i];
+    for ( int k = 0; k < row.size(); ++k ) {
+      sum -= row[k].second * x[row[k].first];
+    }
+    // the diagonal is -t*lambda - theta, never zero for a complex pole
+    x[i] = sum / (t * A(i+1,i+1) - theta);
+  }
+  return x;
+}
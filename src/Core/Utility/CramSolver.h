@@ -0,0 +1,91 @@
+// CramSolver.h
+#ifndef CRAMSOLVER_H
+#define CRAMSOLVER_H
+
+#include "UseMatrixLib.h"
+#include "DecaySolver.h"
+
+#include <complex>
+#include <vector>
+#include <utility>
+
+/**
+   @class CramSolver 
+    
+   A class that solves the matrix exponential problem using the 
+   Chebyshev Rational Approximation Method (CRAM) of order 16. 
+
+   CRAM approximates exp(z) on the negative real axis by a rational 
+   function, which suits decay matrices since their eigenvalues are 
+   the (negative) decay constants. In its incomplete partial fraction 
+   form the approximation needs one linear solve with the shifted 
+   matrix t*A - theta_j*I for each of eight complex poles theta_j. 
+   The cost of a decay is therefore fixed, no matter how long the 
+   decay time or how short-lived the isotopes, and the accuracy is 
+   close to machine precision for all decay times. If the decay matrix 
+   is lower triangular, as the DecayHandler builds it, the shifted 
+   systems are solved by sparse forward substitution. 
+
+   See M. Pusa, "Higher-Order Chebyshev Rational Approximation Method 
+   and Application to Burnup Equations", Nucl. Sci. Eng. 182 (2016). 
+ */
+class CramSolver : public DecaySolver {
+
+  public:
+    /**
+       Solves the decay equation dx/dt = A * x for x(t) = e^(tA) * x(t=0)
+        
+       @param A the decay Matrix 
+       @param x_o the initial condition Vector x(t=0) 
+       @param t the value for which the solution is being evaluated 
+       @return the solution Vector x(t) 
+     */
+    virtual Vector solve(const Matrix & A, const Vector & x_o, double t);
+
+  private:
+    /**
+       a complex number in the precision of the matrix elements 
+     */
+    typedef std::complex<long double> Complex;
+
+    /**
+       the entries below the diagonal of a matrix, row by row, as pairs 
+       of their (0-based) column and value 
+     */
+    typedef std::vector< std::vector< std::pair<int, long double> > > 
+      SparseRows;
+
+    /**
+       Solves (t*A - theta*I) * x = b by Gaussian elimination with 
+       partial pivoting. Eliminations with a zero multiplier are 
+       skipped, so the sparse decay matrices are cheap to solve. 
+        
+       @param A the decay Matrix 
+       @param t the decay time 
+       @param theta the pole by which the diagonal is shifted 
+       @param b the right hand side, in the 0-based order of A's rows 
+       @return the solution x 
+     */
+    static std::vector<Complex> shiftedSolve(const Matrix & A, double t,
+                                             Complex theta, 
+                                             const std::vector<long double> & b);
+
+    /**
+       Solves (t*A - theta*I) * x = b by forward substitution, for a 
+       lower triangular decay matrix A. Only the nonzero entries of A 
+       below its diagonal are visited. 
+        
+       @param A the decay Matrix, lower triangular 
+       @param below the entries of t*A below its diagonal 
+       @param t the decay time 
+       @param theta the pole by which the diagonal is shifted 
+       @param b the right hand side, in the 0-based order of A's rows 
+       @return the solution x 
+     */
+    static std::vector<Complex> forwardSolve(const Matrix & A, 
+                                             const SparseRows & below,
+                                             double t, Complex theta, 
+                                             const std::vector<long double> & b);
+};
+
+#endif
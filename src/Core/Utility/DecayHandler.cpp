@@ -4,6 +4,10 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <cmath>
+#include <set>
+#include <queue>
+#include <functional>
 
 #include "Env.h"
 #include "CycException.h"
@@ -17,6 +21,9 @@ ParentMap DecayHandler::parent_ = ParentMap();
 DaughtersMap DecayHandler::daughters_ = DaughtersMap();
 Matrix DecayHandler::decayMatrix_ = Matrix();
 IsoList DecayHandler::IsotopesTracked_ = IsoList();
+DecaySolverPtr DecayHandler::solver_ = DecaySolverPtr(new UniformTaylor());
+SubgraphMap DecayHandler::subgraphs_;
+double DecayHandler::propagator_interval_ = 0;
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 DecayHandler::DecayHandler() {
@@ -82,7 +89,9 @@ void DecayHandler::loadDecayInfo() {
       }
       decayInfo >> iso; // get next parent
     }
-    // builds the decay matrix from the parent and daughter maps
+    // builds the (lower triangular) decay matrix from the parent and 
+    // daughter maps
+    orderParentsFirst();
     buildDecayMatrix();
   } else {
     throw CycIOException("Could not find file 'decayInfo.dat'.");
@@ -90,77 +99,64 @@ void DecayHandler::loadDecayInfo() {
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void DecayHandler::addIsoToList(int iso) {
-  bool exists = (find(IsotopesTracked_.begin(), IsotopesTracked_.end(),iso)!=IsotopesTracked_.end());
-  if (!exists){
-    IsotopesTracked_.push_back(iso);
+void DecayHandler::orderParentsFirst() {
+  int n = parent_.size();
+  vector<int> n_parents(n + 1, 0);
+  for ( DaughtersMap::const_iterator it = daughters_.begin(); 
+        it != daughters_.end(); ++it ) {
+    for ( int i = 0; i < it->second.size(); ++i ) {
+      ++n_parents.at(parent_.find(it->second[i].first)->second.first);
+    }
   }
-}
 
-//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void DecayHandler::setComp(CompMapPtr comp) {
-  atom_comp_ = comp;
-  buildDecayMatrix();
-}
+  // visits the columns parents first, lowest (file order) column first
+  priority_queue<int, vector<int>, greater<int> > ready;
+  for ( int col = 1; col <= n; ++col ) {
+    if ( n_parents.at(col) == 0 ) {
+      ready.push(col);
+    }
+  }
+  vector<int> new_col(n + 1, 0);
+  int next_col = 1;
+  while ( !ready.empty() ) {
+    int col = ready.top();
+    ready.pop();
+    new_col.at(col) = next_col++;
+    const vector< pair<int, double> >& daughters = daughters_[col];
+    for ( int i = 0; i < daughters.size(); ++i ) {
+      int daughter_col = parent_.find(daughters[i].first)->second.first;
+      if ( --n_parents.at(daughter_col) == 0 ) {
+        ready.push(daughter_col);
+      }
+    }
+  }
 
-//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void DecayHandler::setComp(Vector comp) {
-  atom_comp_.reset(new CompMap(ATOM));
+  if ( next_col != n + 1 ) {
+    LOG(LEV_WARN, "none!") << "The decay chains in 'decayInfo.dat' contain "
+                           << "a cycle; the decay matrix is left unordered.";
+    return;
+  }
 
-  // loops through the ParentMap and populates the new composition map with
-  // the number density from the comp parameter for each isotope
-  ParentMap::const_iterator parent_iter = parent_.begin(); // get first parent
-  while( parent_iter != parent_.end() ) {
-    int iso = parent_iter->first;
-    int col = parent_.find(iso)->second.first; // get Vector position
-    
-    // checks to see if the Vector position is valid
-    if ( col <= comp.numRows() ) {
-      double atom_count = comp(col,1);
-      // adds isotope to the map if its number density is non-zero
-      if ( atom_count != 0 )
-        (*atom_comp_)[iso] = atom_count;
-    } else {
-      LOG(LEV_ERROR, "none!") << "Decay Error - invalid Vector position";
-    }
-    ++parent_iter; // get next parent
+  DaughtersMap reordered;
+  for ( ParentMap::iterator it = parent_.begin(); it != parent_.end(); ++it ) {
+    int col = it->second.first;
+    it->second.first = new_col.at(col);
+    reordered[new_col.at(col)] = daughters_[col];
   }
+  daughters_.swap(reordered);
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Vector DecayHandler::compAsVector() {
-
-  // solves the decay equation for the final composition
-        
-  Vector comp_vector = Vector(parent_.size(),1);
-
-  map<int, double>::const_iterator comp_iter = atom_comp_->begin();
-  while( comp_iter != atom_comp_->end() ) {
-    int iso = comp_iter->first;
-    long double atom_count = comp_iter->second;
-
-    // if the isotope is tracked in the decay matrix  
-    if ( parent_.count(iso) > 0 ) {
-      int col = parent_.find(iso)->second.first; // get Vector position
-      comp_vector(col,1) = atom_count;
-    // if it is not in the decay matrix, then it is added as a stable isotope
-    } else {
-      double decayConst = 0;
-      int col = parent_.size() + 1;
-      parent_[iso] = make_pair(col, decayConst);  // add isotope to parent map
-
-      int nDaughters = 0;
-      vector< pair<int,double> > temp(nDaughters);
-      daughters_[col] = temp;  // add isotope to daughters map
-      
-      vector<long double> row(1, atom_count);
-      comp_vector.addRow(row);  // add isotope to the end of the Vector
-    }
-
-    ++comp_iter; // get next isotope
+void DecayHandler::addIsoToList(int iso) {
+  bool exists = (find(IsotopesTracked_.begin(), IsotopesTracked_.end(),iso)!=IsotopesTracked_.end());
+  if (!exists){
+    IsotopesTracked_.push_back(iso);
   }
+}
 
-  return comp_vector;
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DecayHandler::setComp(CompMapPtr comp) {
+  atom_comp_ = comp;
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -174,6 +170,7 @@ void DecayHandler::buildDecayMatrix() {
   int jcol = 1;
   int n = parent_.size();
   decayMatrix_ = Matrix(n,n);
+  subgraphs_.clear();
 
   ParentMap::const_iterator parent_iter = parent_.begin(); // get first parent
 
@@ -204,10 +201,173 @@ void DecayHandler::buildDecayMatrix() {
   }
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+DecaySubgraph& DecayHandler::subgraph(CompMapPtr comp) {
+  IsoList key;
+  for (CompMap::const_iterator it = comp->begin(); it != comp->end(); ++it) {
+    if ( it->second != 0 ) {
+      key.push_back(it->first);
+    }
+  }
+
+  SubgraphMap::iterator found = subgraphs_.find(key);
+  if ( found != subgraphs_.end() ) {
+    return found->second;
+  }
+
+  // walks the daughters of every radioactive isotope in the composition
+  set<int> reached;
+  vector<int> to_visit;
+  for ( IsoList::const_iterator it = key.begin(); it != key.end(); ++it ) {
+    ParentMap::const_iterator parent = parent_.find(*it);
+    // untracked and stable isotopes are left out of the subgraph
+    if ( parent != parent_.end() && parent->second.second != 0 ) {
+      to_visit.push_back(*it);
+    }
+  }
+  while ( !to_visit.empty() ) {
+    int iso = to_visit.back();
+    to_visit.pop_back();
+    if ( !reached.insert(iso).second ) {
+      continue;
+    }
+    int col = parent_.find(iso)->second.first;
+    const vector< pair<int, double> >& daughters = daughters_.find(col)->second;
+    for ( int i = 0; i < daughters.size(); ++i ) {
+      to_visit.push_back(daughters[i].first);
+    }
+  }
+
+  // orders the subgraph by decay matrix column
+  map<int, int> iso_by_col;
+  for ( set<int>::const_iterator it = reached.begin(); 
+        it != reached.end(); ++it ) {
+    iso_by_col[parent_.find(*it)->second.first] = *it;
+  }
+
+  DecaySubgraph& sub = subgraphs_[key];
+  for ( map<int, int>::const_iterator it = iso_by_col.begin(); 
+        it != iso_by_col.end(); ++it ) {
+    sub.columns.push_back(it->first);
+    sub.isos.push_back(it->second);
+  }
+  int n = sub.columns.size();
+  if ( n > 0 ) {
+    sub.matrix = Matrix(n,n);
+    for ( int i = 0; i < n; ++i ) {
+      for ( int j = 0; j < n; ++j ) {
+        sub.matrix(i+1,j+1) = decayMatrix_(sub.columns[i],sub.columns[j]);
+      }
+    }
+  }
+  return sub;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool DecayHandler::isStable(CompMapPtr comp) {
+  return subgraph(comp).columns.empty();
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void DecayHandler::decay(double years) {
-  // solves the decay equation for the final composition
-  Vector vect = UniformTaylor::matrixExpSolver(decayMatrix_, compAsVector(), years);
-  setComp(vect);
+  DecaySubgraph& sub = subgraph(atom_comp_);
+  int n = sub.isos.size();
+
+  // isotopes outside of the subgraph are stable and carried over as is
+  CompMapPtr decayed(new CompMap(ATOM));
+  for ( CompMap::const_iterator it = atom_comp_->begin(); 
+        it != atom_comp_->end(); ++it ) {
+    if ( it->second != 0 ) {
+      (*decayed)[it->first] = atom_comp_->atomFraction(it->first);
+    }
+  }
+  if ( n == 0 ) {
+    atom_comp_ = decayed;
+    return;
+  }
+
+  Vector comp_vector(n,1);
+  for ( int i = 0; i < n; ++i ) {
+    if ( atom_comp_->count(sub.isos[i]) > 0 ) {
+      comp_vector(i+1,1) = atom_comp_->atomFraction(sub.isos[i]);
+    }
+  }
+
+  // uses the propagators if the time is a multiple of their interval
+  long multiple = 0;
+  if ( propagator_interval_ > 0 ) {
+    double intervals = years / propagator_interval_;
+    multiple = (long)floor(intervals + 0.5);
+    if ( fabs(intervals - multiple) > 1e-9 * intervals ) {
+      multiple = 0;
+    }
+  }
+  Vector vect;
+  if ( multiple > 0 ) {
+    vect = propagate(sub, comp_vector, multiple);
+  } else {
+    // solves the decay equation for the final composition
+    vect = solver_->solve(sub.matrix, comp_vector, years);
+  }
+
+  for ( int i = 0; i < n; ++i ) {
+    if ( vect(i+1,1) > 0 ) {
+      (*decayed)[sub.isos[i]] = vect(i+1,1);
+    } else if ( decayed->count(sub.isos[i]) > 0 ) {
+      decayed->erase(sub.isos[i]);
+    }
+  }
+  atom_comp_ = decayed;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Vector DecayHandler::propagate(DecaySubgraph& sub, Vector comp_vector, 
+                               long multiple) {
+  vector<Matrix>& propagators = sub.propagators;
+  if ( propagators.empty() ) {
+    propagators.push_back(solver_->propagator(sub.matrix, 
+                                              propagator_interval_));
+  }
+  // applies e^(A * 2^k * dt) for each set bit k of the multiple
+  for ( int k = 0; multiple > 0; ++k, multiple >>= 1 ) {
+    if ( k == (int)propagators.size() ) {
+      propagators.push_back(propagators.back() * propagators.back());
+    }
+    if ( multiple & 1 ) {
+      comp_vector = propagators.at(k) * comp_vector;
+    }
+  }
+  return comp_vector;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DecayHandler::setSolver(DecaySolverPtr solver) {
+  // the propagators were built by the previous solver
+  for ( SubgraphMap::iterator it = subgraphs_.begin(); 
+        it != subgraphs_.end(); ++it ) {
+    it->second.propagators.clear();
+  }
+  solver_ = solver;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+DecaySolverPtr DecayHandler::solver() {
+  return solver_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void DecayHandler::setPropagatorInterval(double years) {
+  if ( years != propagator_interval_ ) {
+    for ( SubgraphMap::iterator it = subgraphs_.begin(); 
+          it != subgraphs_.end(); ++it ) {
+      it->second.propagators.clear();
+    }
+  }
+  propagator_interval_ = (years > 0) ? years : 0;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+double DecayHandler::propagatorInterval() {
+  return propagator_interval_;
 }
 
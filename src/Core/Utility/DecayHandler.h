@@ -3,6 +3,7 @@
 #define _DECAYHANDLER_H
 
 #include "UseMatrixLib.h"
+#include "DecaySolver.h"
 #include "IsoVector.h"
 
 /**
@@ -24,6 +25,31 @@ typedef std::map<int, std::vector<std::pair<int, double> > > DaughtersMap;
 
 typedef std::vector<int> IsoList;
 
+/**
+   The part of the decay matrix reachable from the isotopes of a 
+   composition. Isotopes outside of it are stable and unaffected by the 
+   composition's decay. 
+ */
+struct DecaySubgraph {
+  /// the reachable isotopes, in the order of their decay matrix columns
+  IsoList isos;
+
+  /// the decay matrix columns of the reachable isotopes
+  std::vector<int> columns;
+
+  /// the decay matrix restricted to the reachable isotopes
+  Matrix matrix;
+
+  /// the propagators e^(A * 2^k * dt) of the submatrix, in order of k
+  std::vector<Matrix> propagators;
+};
+
+/**
+   A map type to cache the decay subgraphs. The key for this map type is 
+   the (sorted) list of isotopes present in a composition. 
+ */
+typedef std::map<IsoList, DecaySubgraph> SubgraphMap;
+
 class DecayHandler {
   private:
     /**
@@ -39,6 +65,14 @@ class DecayHandler {
      */
     static void loadDecayInfo();
 
+    /**
+       Renumbers the decay matrix columns so that every parent comes 
+       before its daughters, which makes the decay matrix lower 
+       triangular. The file order is kept where the chains allow it, and 
+       entirely if the chains contain a cycle. 
+     */
+    static void orderParentsFirst();
+
     /**
        The IsoVector's parent 
      */
@@ -54,6 +88,45 @@ class DecayHandler {
      */
     static Matrix decayMatrix_; 
 
+    /**
+       The solver used for all decay calculations 
+     */
+    static DecaySolverPtr solver_;
+
+    /**
+       The decay subgraphs of the compositions seen so far, keyed by the 
+       isotopes they contain. Cleared when the decay matrix changes. 
+     */
+    static SubgraphMap subgraphs_;
+
+    /**
+       Returns the decay subgraph of a composition, building and caching 
+       it if this set of isotopes has not been seen before. 
+
+       @param comp the composition 
+       @return the isotopes reachable from comp through decay 
+     */
+    static DecaySubgraph& subgraph(CompMapPtr comp);
+
+    /**
+       The base interval dt of the propagators, in years. Propagators 
+       are not used if this is not positive. 
+     */
+    static double propagator_interval_;
+
+    /**
+       Decays the composition vector by a multiple of the base interval 
+       by applying the propagators of the binary digits of the multiple. 
+       The base propagator is built by the solver. 
+
+       @param sub the subgraph the composition vector is defined on 
+       @param comp_vector the composition to decay 
+       @param multiple the number of base intervals to decay for 
+       @return the decayed composition vector 
+     */
+    static Vector propagate(DecaySubgraph& sub, Vector comp_vector, 
+                            long multiple);
+
     /**
        The atomic composition map 
      */
@@ -85,23 +158,22 @@ class DecayHandler {
      */
     void setComp(CompMapPtr comp);
 
-    /**
-       set the composition from a composition vector 
-     */
-    void setComp(Vector comp);
-
-    /**
-       return the composition as a composition vector 
-     */ 
-    Vector compAsVector();
-
     /**
        return the composition as a composition map 
      */ 
     CompMapPtr comp();
 
     /**
-       decay the material 
+       whether a composition holds no radioactive isotopes, in which 
+       case decaying it leaves it unchanged 
+
+       @param comp the composition 
+     */
+    bool isStable(CompMapPtr comp);
+
+    /**
+       decay the material. only the isotopes reachable from the 
+       composition are included in the calculation. 
        @param years the number of years to decay 
      */ 
     void decay(double years);
@@ -115,6 +187,34 @@ class DecayHandler {
        the tracked isotope at position i 
      */
     int trackedIsotope(int i){return IsotopesTracked_.at(i);}
+
+    /**
+       set the solver used for all decay calculations. the default is 
+       the UniformTaylor solver. clears the cached propagators, which 
+       are built by the solver. 
+     */
+    static void setSolver(DecaySolverPtr solver);
+
+    /**
+       the solver used for all decay calculations 
+     */
+    static DecaySolverPtr solver();
+
+    /**
+       set the base interval of the propagator cache. decays by an integer 
+       multiple of this interval are computed from cached powers of 
+       the solver's propagator over one interval instead of by solving 
+       for the whole time. 
+
+       @param years the base interval, in years. <= 0 turns the 
+       propagators off (default = 0) 
+     */
+    static void setPropagatorInterval(double years);
+
+    /**
+       the base interval of the propagator cache, in years 
+     */
+    static double propagatorInterval();
 };
 
 #endif
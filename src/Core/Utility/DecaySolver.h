@@ -0,0 +1,92 @@
+// DecaySolver.h
+#if !defined(_DECAYSOLVER_H)
+#define _DECAYSOLVER_H
+
+#include "UseMatrixLib.h"
+
+#include <boost/shared_ptr.hpp>
+
+/**
+   a shared pointer to a decay solver
+ */
+class DecaySolver;
+typedef boost::shared_ptr<DecaySolver> DecaySolverPtr;
+
+/**
+   @class DecaySolver
+
+   The interface to the methods the DecayHandler may use to solve the
+   decay equation. A solver is given the decay matrix, whose columns
+   hold each parent's decay constant (as -lambda on the diagonal) and
+   its daughters' production rates, and the initial composition as a
+   vector of atoms.
+ */
+class DecaySolver {
+ public:
+  /**
+     virtual destructor for the interface
+   */
+  virtual ~DecaySolver() {};
+
+  /**
+     Solves the decay equation: 
+        
+     dx(t) 
+     -----  =  A * x(t) 
+     dt 
+        
+     where A is an nxn Matrix and x(t) is an nx1 Vector.
+        
+     @param A the decay Matrix, in inverse years
+     @param x_o the initial condition Vector x(t=0) 
+     @param t the decay time, in years
+     @return the solution Vector x(t) 
+   */
+  virtual Vector solve(const Matrix & A, const Vector & x_o, double t) = 0;
+
+  /**
+     Computes the propagator e^(tA), the Matrix that decays any initial 
+     condition by t. By default each column j is the solution for the 
+     unit vector of isotope j. Solvers that compute the matrix 
+     exponential directly may override this. 
+
+     @param A the decay Matrix, in inverse years 
+     @param t the decay time, in years 
+     @return the propagator Matrix 
+   */
+  virtual Matrix propagator(const Matrix & A, double t) {
+    int n = A.numRows();
+    Matrix prop(n,n);
+    for (int j = 1; j <= n; ++j) {
+      Vector unit(n,1);
+      unit(j,1) = 1;
+      Vector column = solve(A, unit, t);
+      for (int i = 1; i <= n; ++i) {
+        prop(i,j) = column(i,1);
+      }
+    }
+    return prop;
+  }
+
+ protected:
+  /**
+     Returns true if the decay matrix has no entries above its diagonal, 
+     i.e. if every parent comes before its daughters. The DecayHandler 
+     orders the isotopes this way whenever the decay chains allow it. 
+
+     @param A the decay Matrix 
+   */
+  static bool isLowerTriangular(const Matrix & A) {
+    int n = A.numRows();
+    for (int i = 1; i <= n; ++i) {
+      for (int j = i + 1; j <= n; ++j) {
+        if (A(i,j) != 0) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+};
+
+#endif
@@ -23,10 +23,16 @@
 //
 //   * powers of a matrix:       A ^ k
 //   * scalar multiplication:    k * A or A * k
-// 
+//
 // The non-member function identity(int n) creates and returns an nxn identity
 // matrix.
 //
+// The elements are stored in a single row-major buffer.  Matrix products are
+// computed block by block so that the blocks of both operands stay in cache,
+// and powers are computed by repeated squaring.  Everything here is written
+// for the DenseMatrix template and instantiated at the bottom of this file
+// for long double (LMatrix) and double (DMatrix).
+//
 // Note: when referring to the elements of a LMatrix object, the indices for the
 // rows and columns start from 1.
 //-----------------------------------------------------------------------------
@@ -35,80 +41,100 @@
 
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <stdexcept>
 
 using namespace std;
 
+// the number of rows and columns in a block of a blocked matrix product
+
+static const int kBlockSize = 64;
+
 // constructs a 1x1 matrix of zeroes
 
-LMatrix::LMatrix() {
-  rows_ = 1;                   // sets number of rows
-  cols_ = 1;                   // sets number of columns
-  vector<long double> element(1);  // creates a single element
-  M_.push_back(element);       // adds element to the matrix
+template <class T>
+DenseMatrix<T>::DenseMatrix() {
+  rows_ = 1;       // sets number of rows
+  cols_ = 1;       // sets number of columns
+  M_.assign(1,0);  // creates a single element
 }
 
 // constructs an nxm matrix of zeroes
 
-LMatrix::LMatrix(int n, int m) {
-  rows_ = n;                     // sets number of rows
-  cols_ = m;                     // sets number of columns
-  vector<long double> row(m);   // creates a row with m elements
-  M_.assign(n,row);              // adds n rows_ to the matrix
+template <class T>
+DenseMatrix<T>::DenseMatrix(int n, int m) {
+  rows_ = n;          // sets number of rows
+  cols_ = m;          // sets number of columns
+  M_.assign(n*m,0);   // creates n rows of m elements
 }
 
 // returns the number of rows n in the matrix
 
-int LMatrix::numRows() const {
+template <class T>
+int DenseMatrix<T>::numRows() const {
   return rows_;
 }
 
 // returns the number of columns m in the matrix
 
-int LMatrix::numCols() const {
+template <class T>
+int DenseMatrix<T>::numCols() const {
   return cols_;
 }
 
-// overloads the () operator so that A(i,j) will return a reference to 
+// overloads the () operator so that A(i,j) will return a reference to
 // the element aij
 
-const long double & LMatrix::operator()(int i, int j) const {
-  return M_.at(i-1).at(j-1);
+template <class T>
+const T & DenseMatrix<T>::operator()(int i, int j) const {
+  if (j < 1 || j > cols_) {
+    throw out_of_range("DenseMatrix column index is out of range");
+  }
+  return M_.at((i-1)*cols_ + (j-1));
 }
 
 // sets the value for the element aij at row i and column j
 
-void LMatrix::setElement(int i, int j, long double aij) {
-  M_.at(i-1).at(j-1) = aij; 
+template <class T>
+void DenseMatrix<T>::setElement(int i, int j, T aij) {
+  (*this)(i,j) = aij;
 }
 
 // overloads the () operator so that A(i,j) will write the element aij
 
-long double & LMatrix::operator()(int i, int j) {
-  return M_.at(i-1).at(j-1);
+template <class T>
+T & DenseMatrix<T>::operator()(int i, int j) {
+  if (j < 1 || j > cols_) {
+    throw out_of_range("DenseMatrix column index is out of range");
+  }
+  return M_.at((i-1)*cols_ + (j-1));
 }
 
 // adds a row at the end of the Matrix if it contains the same number of
 // elements as the number of columns in the Matrix
-void LMatrix::addRow(std::vector<long double> row) {
+
+template <class T>
+void DenseMatrix<T>::addRow(std::vector<T> row) {
   int size = row.size();
   if ( size == cols_ ) {
-    M_.push_back(row);
+    M_.insert(M_.end(), row.begin(), row.end());
     ++rows_;  // increase the number of rows
   }
 }
 
 // prints the matrix to standard output
 
-void LMatrix::print() const {
+template <class T>
+void DenseMatrix<T>::print() const {
   cout.setf(ios::showpoint);
   cout.setf(ios::scientific);
 
   // sets elements to display 6 decimal places
   cout << setiosflags(ios::fixed) << setprecision(10);
-  
+
   // prints single element if M is a 1x1 matrix
-  if (M_.capacity() == 1 && M_[0].capacity() == 1) {
-    cout << "[ " << M_.at(0).at(0) << " ]" << endl;
+  if (rows_ == 1 && cols_ == 1) {
+    cout << "[ " << M_.at(0) << " ]" << endl;
   }
   else {
     // loops through the rows of the matrix
@@ -116,68 +142,67 @@ void LMatrix::print() const {
       // prints all of the elements in the ith row of the matrix
       cout << "[";
       for (int j = 0; j < cols_ - 1; j++) {
-	cout << "  " << setw(9) << M_.at(i).at(j)  << "  ";
+	cout << "  " << setw(9) << M_.at(i*cols_ + j)  << "  ";
       }
-      cout << setw(9) << M_.at(i).at(cols_ - 1) << "  ]" << endl;
+      cout << setw(9) << M_.at(i*cols_ + cols_ - 1) << "  ]" << endl;
     }
   }
 }
 
-// overloads the assignment operator "A = B" for matrix objects
+// creates and returns an nxn identity matrix I
+
+template <class T>
+DenseMatrix<T> DenseMatrix<T>::identity(int n) {
+  DenseMatrix<T> I(n,n);
 
-const LMatrix & LMatrix::operator=(const LMatrix & rhs) {
-  if (this == &rhs) {
-    return *this;     // returns A if it is already the same matrix as B
+  for (int i = 0; i < n ; i++) {
+    I.M_[i*n + i] = 1;
   }
-  else {
-    M_.empty();        // removes the original elements of A
-    rows_ = rhs.rows_;  // resets the number of rows to match B
-    cols_ = rhs.cols_;  // resets the number of columns to match B 
-    
-    // rebuilds A with the dimensions of B
-    vector<long double> row(cols_);
-    M_.assign(rows_,row);
-    
-    // copies all of the elements from B into A
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        M_.at(i).at(j) = rhs(i+1, j+1);
-      }
-    }
 
-    return *this;  // returns the new matrix "A = B"
+  return I;  // returns the nxn identity matrix
+}
+
+// overloads the assignment operator "A = B" for matrix objects
+
+template <class T>
+const DenseMatrix<T> & DenseMatrix<T>::operator=(const DenseMatrix<T> & rhs) {
+  if (this != &rhs) {
+    rows_ = rhs.rows_;  // resets the number of rows to match B
+    cols_ = rhs.cols_;  // resets the number of columns to match B
+    M_ = rhs.M_;        // copies all of the elements from B into A
   }
+  return *this;  // returns the new matrix "A = B"
 }
 
 // overloads the assignment operator "A = A + B" for matrix objects
 // Note: if the matrix dimensions do not match, then A is returned unchanged
 
-const LMatrix & LMatrix::operator+=(const LMatrix & rhs) {
+template <class T>
+const DenseMatrix<T> & DenseMatrix<T>::operator+=(const DenseMatrix<T> & rhs) {
   if (this->rows_ == rhs.rows_ && this->cols_ == rhs.cols_) {
     // performs matrix addition and stores the result in A
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        M_.at(i).at(j) = M_.at(i).at(j) + rhs(i+1, j+1);
-      }
+    int size = M_.size();
+    for (int i = 0; i < size; i++) {
+      M_[i] += rhs.M_[i];
     }
   }
-  
+
   return *this;  // returns the new matrix "A = A + B"
 }
 
 // overloads the assignment operator "A = A - B" for matrix objects
 // Note: if the matrix dimensions do not match, then A is returned unchanged
 
-const LMatrix & LMatrix::operator-=(const LMatrix & rhs) {
+template <class T>
+const DenseMatrix<T> & DenseMatrix<T>::operator-=(const DenseMatrix<T> & rhs) {
   if (this->rows_ == rhs.rows_ && this->cols_ == rhs.cols_) {
     // performs matrix subtraction and stores the result in A
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        M_.at(i).at(j) = M_.at(i).at(j) - rhs(i+1, j+1);
-      }
+    int size = M_.size();
+    for (int i = 0; i < size; i++) {
+      M_[i] -= rhs.M_[i];
     }
   }
-  
+
   return *this;  // returns the new matrix "A = A - B"
 }
 
@@ -188,106 +213,146 @@ const LMatrix & LMatrix::operator-=(const LMatrix & rhs) {
 // cannot be multipled due to having incorrect dimensions for matrix
 // multiplication to be defined, then A will be returned unchanged
 
-const LMatrix & LMatrix::operator*=(const LMatrix & rhs) {
-  long double aij;  // stores temporary matrix element for row i and column j
-  
-  // creates a new matrix called temp with the number of rows of A and the
-  // number of columns of B
-  LMatrix temp(this->rows_,rhs.cols_);
-
+template <class T>
+const DenseMatrix<T> & DenseMatrix<T>::operator*=(const DenseMatrix<T> & rhs) {
   // performs matrix multiplication if the number of columns of A equals the
   // number of rows of B
   if (this->cols_ == rhs.rows_) {
-    // multiplies row vector i of A by the column vector j of B and stores
-    // the result in the new matrix temp as element aij
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < rhs.cols_; j++) {
-        aij = 0;  // resets the sum for the next element
-        
-        // sums the product of the row vector from A and the column vector
-        // from B using the formula aij = ai1*b1j + ai2*b2j + ...
-        for (int k = 0; k < rows_; k++) {
-          aij = aij + M_.at(i).at(k) * rhs(k+1,j+1);
+    int n = rows_;      // rows of the product
+    int m = rhs.cols_;  // columns of the product
+    int l = cols_;      // length of the sums
+
+    // creates a new matrix called temp with the number of rows of A and the
+    // number of columns of B
+    DenseMatrix<T> temp(n,m);
+    if (temp.M_.empty() || M_.empty()) {
+      *this = temp;  // one of the matrices has no elements
+      return *this;
+    }
+    T* c = &temp.M_[0];
+    const T* a = &M_[0];
+    const T* b = &rhs.M_[0];
+
+    // adds the product of each block of A and block of B into the block of
+    // temp they contribute to. within a block, row i of B scaled by aik is
+    // added to row i of temp, so that the inner loop runs over contiguous
+    // elements. each element is still summed in the order aij = ai1*b1j +
+    // ai2*b2j + ...
+    for (int ii = 0; ii < n; ii += kBlockSize) {
+      int i_end = min(ii + kBlockSize, n);
+      for (int kk = 0; kk < l; kk += kBlockSize) {
+        int k_end = min(kk + kBlockSize, l);
+        for (int jj = 0; jj < m; jj += kBlockSize) {
+          int j_end = min(jj + kBlockSize, m);
+          for (int i = ii; i < i_end; i++) {
+            T* c_row = c + i*m;
+            for (int k = kk; k < k_end; k++) {
+              T aik = a[i*l + k];
+              if (aik == 0) {
+                continue; // decay matrices are mostly zeroes
+              }
+              const T* b_row = b + k*m;
+              for (int j = jj; j < j_end; j++) {
+                c_row[j] += aik * b_row[j];
+              }
+            }
+          }
         }
-        
-        temp.setElement(i+1, j+1, aij);  // copies element aij into temp
       }
-    }   
-    
+    }
+
     *this = temp;  // sets the new matrix "A = A * B"
   }
 
   return *this;  // returns the new matrix "A = A * B"
 }
 
+// overloads the assignment operator "A = k * A" for a scalar k
+
+template <class T>
+const DenseMatrix<T> & DenseMatrix<T>::operator*=(const T k) {
+  // multiplies every element in the matrix A by the scalar k
+  int size = M_.size();
+  for (int i = 0; i < size; i++) {
+    M_[i] *= k;
+  }
+
+  return *this;  // returns the new matrix "A = k * A"
+}
+
 // overloads the arithmetic operator "A + B" for matrix objects
 
-LMatrix operator+(const LMatrix & lhs, const LMatrix & rhs) {
-  LMatrix ans(lhs);
-  ans += rhs; 
+template <class T>
+DenseMatrix<T> operator+(const DenseMatrix<T> & lhs,
+                         const DenseMatrix<T> & rhs) {
+  DenseMatrix<T> ans(lhs);
+  ans += rhs;
   return ans;  // returns the resulting matrix A + B
 }
 
 // overloads the arithmetic operator "A - B" for matrix objects
 
-LMatrix operator-(const LMatrix & lhs, const LMatrix & rhs) {
-  LMatrix ans(lhs);
+template <class T>
+DenseMatrix<T> operator-(const DenseMatrix<T> & lhs,
+                         const DenseMatrix<T> & rhs) {
+  DenseMatrix<T> ans(lhs);
   ans -= rhs;
   return ans;  // returns the resulting matrix A - B
 }
 
 // overloads the arithmetic operator "A * B" for matrix objects
 
-LMatrix operator*(const LMatrix & lhs, const LMatrix & rhs) {
-  LMatrix ans(lhs);
+template <class T>
+DenseMatrix<T> operator*(const DenseMatrix<T> & lhs,
+                         const DenseMatrix<T> & rhs) {
+  DenseMatrix<T> ans(lhs);
   ans *= rhs;
   return ans;  // returns the resulting matrix A * B
 }
 
-// friend of the Matrix class that performs scalar multiplication k * A
-
-LMatrix operator*(const long double k, const LMatrix & A) {
-  LMatrix ans(A);  // copies A into a new matrix called ans
-  long double aij;
- 
-  // multiplies every element in the matrix A by the scalar k
-  for (int i = 0; i < A.rows_; i++) {
-    for (int j = 0; j < A.cols_; j++) {
-      aij = A(i+1, j+1) * k;
-      ans.setElement(i+1, j+1, aij);
-    }
-  }
+// performs scalar multiplication k * A
 
+template <class T>
+DenseMatrix<T> operator*(const typename DenseMatrix<T>::value_type k,
+                         const DenseMatrix<T> & A) {
+  DenseMatrix<T> ans(A);  // copies A into a new matrix called ans
+  ans *= k;
   return ans;  // returns the resulting matrix k * A
 }
 
-// friend of the Matrix class that performs scalar multiplication A * k
-
-LMatrix operator*(const LMatrix & A, const long double k) {
-  LMatrix ans(A);  // copies A into a new matrix called ans
-  long double aij;
-  
-  // multiplies every element in the matrix A by the scalar k
-  for (int i = 0; i < A.rows_; i++) {
-    for (int j = 0; j < A.cols_; j++) {
-      aij = A(i+1, j+1) * k;
-      ans.setElement(i+1, j+1, aij);
-    }
-  }
+// performs scalar multiplication A * k
 
+template <class T>
+DenseMatrix<T> operator*(const DenseMatrix<T> & A,
+                         const typename DenseMatrix<T>::value_type k) {
+  DenseMatrix<T> ans(A);  // copies A into a new matrix called ans
+  ans *= k;
   return ans;  // returns the resulting matrix A * k
 }
 
-// friend of the Matrix class that calculates powers of a square matrix A ^ k
-// Note: if the matrix is not square, then A is returned unchanged
+// calculates powers of a square matrix A ^ k by repeated squaring, which
+// takes O(log k) matrix products rather than k - 1
+// Note: if the matrix is not square or k < 1, then A is returned unchanged
+
+template <class T>
+DenseMatrix<T> operator^(const DenseMatrix<T> & A, const int k) {
+  if (A.numCols() != A.numRows() || k < 1) {
+    return A;
+  }
+
+  DenseMatrix<T> square(A);  // holds A^(2^j) for the current bit j of k
+  int power = k;
+  while (!(power & 1)) {
+    square *= square;
+    power >>= 1;
+  }
+  DenseMatrix<T> ans(square);  // starts from the lowest set bit of k
 
-LMatrix operator^(const LMatrix & A, const int k) {
-  LMatrix ans(A);  // copies A into a new matrix called ans
- 
-  // multiplies A by itself k times if the matrix is square
-  if (A.cols_ == A.rows_) {
-    for (int i = 0; i < k-1; i++) {
-      ans *= A; 
+  // multiplies in A^(2^j) for each remaining set bit j of k
+  for (power >>= 1; power > 0; power >>= 1) {
+    square *= square;
+    if (power & 1) {
+      ans *= square;
     }
   }
 
@@ -297,11 +362,22 @@ LMatrix operator^(const LMatrix & A, const int k) {
 // creates and returns an nxn identity matrix I
 
 LMatrix identity(int n) {
-  LMatrix I(n,n);
+  return LMatrix::identity(n);  // returns the nxn identity matrix
+}
 
-  for (int i = 0; i < n ; i++) {
-    I.setElement(i+1, i+1, 1);
-  }
-  
-  return I;  // returns the nxn identity matrix
-} 
+// instantiates the matrix types used in cyclus
+
+#define INSTANTIATE_DENSE_MATRIX(T)                                          \
+  template class DenseMatrix<T>;                                             \
+  template DenseMatrix<T> operator+(const DenseMatrix<T> &,                  \
+                                    const DenseMatrix<T> &);                 \
+  template DenseMatrix<T> operator-(const DenseMatrix<T> &,                  \
+                                    const DenseMatrix<T> &);                 \
+  template DenseMatrix<T> operator*(const DenseMatrix<T> &,                  \
+                                    const DenseMatrix<T> &);                 \
+  template DenseMatrix<T> operator*<T>(const T, const DenseMatrix<T> &);     \
+  template DenseMatrix<T> operator*<T>(const DenseMatrix<T> &, const T);     \
+  template DenseMatrix<T> operator^(const DenseMatrix<T> &, const int);
+
+INSTANTIATE_DENSE_MATRIX(long double)
+INSTANTIATE_DENSE_MATRIX(double)
@@ -2,6 +2,10 @@
 // This is the header file for the LMatrix class.  Specific class details can
 // be found in the "LMatrix.cpp" file.  This is the same as the Matrix class
 // except its elements are long doubles.
+//
+// LMatrix is the long double instantiation of the DenseMatrix class template.
+// The double instantiation, DMatrix, trades precision for speed; its
+// multiplication loops are simple enough for the compiler to vectorize.
 //-----------------------------------------------------------------------------
 
 #ifndef LMATRIX_H
@@ -9,48 +13,68 @@
 
 #include <vector>
 
-class LMatrix {
-
-  // friend arithmetic operators involving a scalar k and matrix A
-  friend LMatrix operator*(const long double k, const LMatrix & A);  // k * A
-  friend LMatrix operator*(const LMatrix & A, const long double k);  // A * k
-  friend LMatrix operator^(const LMatrix & A, const int k);     // A^k
+template <class T>
+class DenseMatrix {
 
   public:
+    typedef T value_type;  // the type of the matrix elements
+
     // constructors
-    LMatrix();              // constructs a 1x1 matrix of zeroes
-    LMatrix(int n, int m);  // constructs an nxm matrix of zeroes
-    
+    DenseMatrix();              // constructs a 1x1 matrix of zeroes
+    DenseMatrix(int n, int m);  // constructs an nxm matrix of zeroes
+
     // member access functions
     int numRows() const;                    // returns number of rows
     int numCols() const;                    // returns number of columns
-    const long double & operator()(int i, int j) const;  // returns the element aij
+    const T & operator()(int i, int j) const;  // returns the element aij
 
     // population functions
-    void setElement(int i, int j, long double aij);  // sets value of element aij
-    long double & operator()(int i, int j);  // sets value of element A(i,j)
-    void addRow(std::vector<long double> row);  // adds a row at the end of the Matrix
+    void setElement(int i, int j, T aij);  // sets value of element aij
+    T & operator()(int i, int j);  // sets value of element A(i,j)
+    void addRow(std::vector<T> row);  // adds a row at the end of the Matrix
 
     // other member functions
     void print() const;  // prints the matrix
+    static DenseMatrix identity(int n);  // creates an nxn identity matrix
 
     // assignment operators for matrix objects
-    const LMatrix & operator=(const LMatrix & rhs);
-    const LMatrix & operator+=(const LMatrix & rhs);
-    const LMatrix & operator-=(const LMatrix & rhs);
-    const LMatrix & operator*=(const LMatrix & rhs);
+    const DenseMatrix & operator=(const DenseMatrix & rhs);
+    const DenseMatrix & operator+=(const DenseMatrix & rhs);
+    const DenseMatrix & operator-=(const DenseMatrix & rhs);
+    const DenseMatrix & operator*=(const DenseMatrix & rhs);
+    const DenseMatrix & operator*=(const T k);  // A = k * A
 
   private:
-    std::vector< std::vector<long double> > M_;  // 2D vector containing matrix elements
-    int rows_;                    // number of rows
-    int cols_;                    // number of columns
+    std::vector<T> M_;  // matrix elements, stored row by row
+    int rows_;          // number of rows
+    int cols_;          // number of columns
 
 };
 
 // arithmetic operators for matrix objects A and B
-LMatrix operator+(const LMatrix & lhs, const LMatrix & rhs);  // A + B
-LMatrix operator-(const LMatrix & lhs, const LMatrix & rhs);  // A - B
-LMatrix operator*(const LMatrix & lhs, const LMatrix & rhs);  // A * B
+template <class T>
+DenseMatrix<T> operator+(const DenseMatrix<T> & lhs,
+                         const DenseMatrix<T> & rhs);  // A + B
+template <class T>
+DenseMatrix<T> operator-(const DenseMatrix<T> & lhs,
+                         const DenseMatrix<T> & rhs);  // A - B
+template <class T>
+DenseMatrix<T> operator*(const DenseMatrix<T> & lhs,
+                         const DenseMatrix<T> & rhs);  // A * B
+
+// arithmetic operators involving a scalar k and matrix A
+template <class T>
+DenseMatrix<T> operator*(const typename DenseMatrix<T>::value_type k,
+                         const DenseMatrix<T> & A);  // k * A
+template <class T>
+DenseMatrix<T> operator*(const DenseMatrix<T> & A,
+                         const typename DenseMatrix<T>::value_type k);  // A * k
+template <class T>
+DenseMatrix<T> operator^(const DenseMatrix<T> & A, const int k);  // A^k
+
+// the matrix types used in cyclus, instantiated in LMatrix.cpp
+typedef DenseMatrix<long double> LMatrix;
+typedef DenseMatrix<double> DMatrix;
 
 // non-member functions
 LMatrix identity(int n);  // creates an nxn identity matrix
@@ -4,23 +4,90 @@
 #include "RecipeLibrary.h"
 
 #include "CompMap.h"
+#include "IsoVector.h"
+#include "DecayHandler.h"
 #include "MassTable.h"
 #include "CycException.h"
+#include "Logger.h"
 
 #include <map>
+#include <vector>
 #include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdint.h>
+#include <zlib.h>
+#include <boost/thread.hpp>
 
 using namespace std;
 
+namespace {
+  /**
+     A task for the threads of RecipeLibrary::prewarmDecayCache(). Each
+     thread takes the next decay from a shared list until none are left.
+   */
+  class DecayWorker {
+   public:
+    typedef CompMapPtr (*DecayFunction)(const DecayKey&);
+
+    DecayWorker(DecayFunction decay, const vector<DecayKey>& jobs, 
+                vector<CompMapPtr>& children, int& next_job, 
+                boost::mutex& lock) 
+      : decay_(decay), jobs_(jobs), children_(children), 
+        next_job_(next_job), lock_(lock) {}
+
+    void operator()() {
+      while (true) {
+        int job;
+        {
+          boost::mutex::scoped_lock guard(lock_);
+          if (next_job_ >= (int)jobs_.size()) {
+            return;
+          }
+          job = next_job_++;
+        }
+        if (!children_[job]) {
+          children_[job] = decay_(jobs_[job]);
+        }
+      }
+    }
+
+   private:
+    DecayFunction decay_;
+    const vector<DecayKey>& jobs_;
+    vector<CompMapPtr>& children_;
+    int& next_job_;
+    boost::mutex& lock_;
+  };
+}
+
 // initialize singleton member
 RecipeLibrary* RecipeLibrary::instance_ = 0;
 // initialize recordging members
-int RecipeLibrary::nextStateID_ = 0;
+int RecipeLibrary::nextStateID_ = 1;
 RecipeMap RecipeLibrary::recipes_;
 DecayHistMap RecipeLibrary::decay_hist_;
 DecayTimesMap RecipeLibrary::decay_times_;
+DecayIDMap RecipeLibrary::decay_ids_;
+DecayUsageList RecipeLibrary::decay_usage_;
+DecayUsageMap RecipeLibrary::decay_usage_index_;
+long RecipeLibrary::decay_cache_capacity_ = 64 * 1024 * 1024;
+long RecipeLibrary::decay_cache_memory_ = 0;
+int RecipeLibrary::decay_cache_hits_ = 0;
+int RecipeLibrary::decay_cache_misses_ = 0;
+int RecipeLibrary::decay_cache_evictions_ = 0;
 // initialize table member
 table_ptr RecipeLibrary::iso_table = table_ptr(new Table("IsotopicStates")); 
+table_ptr RecipeLibrary::iso_parent_table = 
+  table_ptr(new Table("IsotopicStateParents")); 
+bool RecipeLibrary::compact_output_ = false;
+bool RecipeLibrary::blob_output_ = false;
+bool RecipeLibrary::compress_blobs_ = false;
+FingerprintMap RecipeLibrary::fingerprints_;
+FingerprintUsageList RecipeLibrary::fingerprint_usage_;
+long RecipeLibrary::fingerprint_capacity_ = 16 * 1024 * 1024;
+long RecipeLibrary::fingerprint_memory_ = 0;
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -  
 RecipeLibrary* RecipeLibrary::Instance() {
@@ -112,8 +179,25 @@ bool RecipeLibrary::recipeRecorded(std::string name) {
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 void RecipeLibrary::recordRecipe(CompMapPtr recipe) {
   if (!recipe->recorded()) {
-    recipe->ID_ = nextStateID_++;
-    addToTable(recipe);
+    if (compact_output_) {
+      if (!recipe->normalized()) {
+        recipe->normalize();
+      }
+      Fingerprint print = fingerprint(recipe);
+      FingerprintMap::iterator written = fingerprints_.find(print);
+      if (written != fingerprints_.end()) {
+        fingerprint_usage_.splice(fingerprint_usage_.begin(),
+                                  fingerprint_usage_,written->second.usage);
+        recipe->ID_ = written->second.id; // already in the db
+        return;
+      }
+      recipe->ID_ = nextStateID_++;
+      rememberFingerprint(print,recipe->ID_);
+      addCompactToTable(recipe);
+    } else {
+      recipe->ID_ = nextStateID_++;
+      addToTable(recipe);
+    }
   }
 }
 
@@ -136,8 +220,17 @@ void RecipeLibrary::storeDecayableRecipe(CompMapPtr recipe) {
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 void RecipeLibrary::recordRecipeDecay(CompMapPtr parent, CompMapPtr child, double t_f) {
   addDecayTime(parent,t_f);
+  ChildIDMap& ids = decay_ids_[parent];
+  if (ids.count(t_f) != 0) {
+    child->ID_ = ids[t_f]; // recomputed after eviction, already in the db
+  }
+  else {
+    recordRecipe(child);
+    ids[t_f] = child->ID();
+  }
   addChild(parent,child,t_f);
-  recordRecipe(child);
+  decay_cache_misses_++;
+  enforceDecayCacheCapacity();
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -196,6 +289,8 @@ ChildMap& RecipeLibrary::Children(CompMapPtr parent) {
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 CompMapPtr& RecipeLibrary::Child(CompMapPtr parent, double time) {
   checkChild(parent,time);
+  touchChild(parent,time);
+  decay_cache_hits_++;
   return Children(parent)[time];
 }
 
@@ -209,7 +304,156 @@ bool RecipeLibrary::childRecorded(CompMapPtr parent, double time) {
 void RecipeLibrary::addChild(CompMapPtr parent, CompMapPtr child, double time) {
   child->parent_ = parent;
   child->decay_time_ = time;
-  Child(parent,time) = child; // child is copied
+  ChildMap& children = Children(parent);
+  if (children.count(time) != 0) {
+    decay_cache_memory_ -= approxMemory(children[time]);
+  }
+  children[time] = child; // child is copied
+  decay_cache_memory_ += approxMemory(child);
+  touchChild(parent,time);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+void RecipeLibrary::touchChild(CompMapPtr parent, double time) {
+  DecayKey key(parent,time);
+  DecayUsageMap::iterator it = decay_usage_index_.find(key);
+  if (it != decay_usage_index_.end()) {
+    decay_usage_.splice(decay_usage_.begin(),decay_usage_,it->second);
+  }
+  else {
+    decay_usage_.push_front(key);
+    decay_usage_index_[key] = decay_usage_.begin();
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+void RecipeLibrary::enforceDecayCacheCapacity() {
+  while (decay_cache_memory_ > decay_cache_capacity_ && 
+         decay_usage_.size() > 1) {
+    DecayKey key = decay_usage_.back();
+    decay_usage_.pop_back();
+    decay_usage_index_.erase(key);
+    ChildMap& children = Children(key.first);
+    decay_cache_memory_ -= approxMemory(children[key.second]);
+    children.erase(key.second);
+    decay_cache_evictions_++;
+    CLOG(LEV_DEBUG3) << "Evicted the child of recipe with id:" 
+                     << key.first->ID() << " at decay time:" << key.second
+                     << " from the decay cache.";
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+long RecipeLibrary::approxMemory(CompMapPtr comp) {
+  // each isotope is a map node in the composition and its cached basis
+  long node = sizeof(Map::value_type) + 4 * sizeof(void*);
+  return sizeof(CompMap) + 2 * comp->size() * node;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+void RecipeLibrary::setDecayCacheCapacity(long bytes) {
+  decay_cache_capacity_ = bytes;
+  enforceDecayCacheCapacity();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+long RecipeLibrary::decayCacheCapacity() {
+  return decay_cache_capacity_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+long RecipeLibrary::decayCacheMemory() {
+  return decay_cache_memory_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+int RecipeLibrary::decayCacheSize() {
+  return decay_usage_.size();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+int RecipeLibrary::decayCacheHits() {
+  return decay_cache_hits_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+int RecipeLibrary::decayCacheMisses() {
+  return decay_cache_misses_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+int RecipeLibrary::decayCacheEvictions() {
+  return decay_cache_evictions_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+void RecipeLibrary::prewarmDecayCache(int duration, int interval, 
+                                      int n_threads) {
+  if (interval <= 0) {
+    return;
+  }
+  if (n_threads <= 0) {
+    n_threads = max(1, (int)boost::thread::hardware_concurrency());
+  }
+
+  // lists the missing children of each recipe, longest decay first
+  vector<DecayKey> jobs;
+  DecayHandler handler;
+  for (DecayHistMap::iterator it = decay_hist_.begin(); 
+       it != decay_hist_.end(); ++it) {
+    CompMapPtr recipe = it->first;
+    if (handler.isStable(recipe)) {
+      continue; // stable recipes are never decayed
+    }
+    for (int t = duration - duration % interval; t > 0; t -= interval) {
+      if (!childRecorded(recipe,t)) {
+        jobs.push_back(DecayKey(recipe,t));
+      }
+    }
+  }
+
+  // the first decay of each recipe is done here. it fills the caches the 
+  // DecayHandler and the recipe keep for it, which the threads then only 
+  // read
+  vector<CompMapPtr> children(jobs.size());
+  for (int i = 0; i < jobs.size(); i++) {
+    if (i == 0 || jobs[i].first != jobs[i-1].first) {
+      children[i] = decayRecipe(jobs[i]);
+    }
+  }
+
+  int next_job = 0;
+  boost::mutex lock;
+  boost::thread_group threads;
+  for (int i = 0; i < n_threads; i++) {
+    threads.create_thread(DecayWorker(&decayRecipe,jobs,children,next_job,
+                                      lock));
+  }
+  threads.join_all();
+
+  // the earliest children are recorded last, so that they are the ones 
+  // kept if the cache cannot hold them all
+  int n_warmed = 0;
+  for (int i = 0; i < jobs.size(); i++) {
+    if (children[i]) {
+      recordRecipeDecay(jobs[i].first,children[i],jobs[i].second);
+      n_warmed++;
+    }
+  }
+  CLOG(LEV_INFO2) << "Pre-computed " << n_warmed << " decayed recipes on " 
+                  << n_threads << " threads.";
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+CompMapPtr RecipeLibrary::decayRecipe(const DecayKey& key) {
+  CompMapPtr child;
+  try {
+    child = IsoVector::executeDecay(key.first,key.second);
+  } catch (CycException& e) {
+    // left for the simulation to compute, and report, if it is needed
+    child.reset();
+  }
+  return child;
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
@@ -219,15 +463,93 @@ bool RecipeLibrary::compositionDecayable(CompMapPtr comp) {
   return (count1 != 0 && count2 != 0); // true iff comp in both 
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+void RecipeLibrary::setCompactOutput(bool compact) {
+  compact_output_ = compact;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+bool RecipeLibrary::compactOutput() {
+  return compact_output_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+void RecipeLibrary::setFingerprintCapacity(long bytes) {
+  fingerprint_capacity_ = bytes;
+  enforceFingerprintCapacity();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+long RecipeLibrary::fingerprintCapacity() {
+  return fingerprint_capacity_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+long RecipeLibrary::fingerprintMemory() {
+  return fingerprint_memory_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+void RecipeLibrary::rememberFingerprint(const Fingerprint& print, int id) {
+  WrittenComposition written;
+  written.id = id;
+  FingerprintMap::iterator it = 
+    fingerprints_.insert(make_pair(print,written)).first;
+  fingerprint_usage_.push_front(&it->first);
+  it->second.usage = fingerprint_usage_.begin();
+  fingerprint_memory_ += approxMemory(it->first);
+  enforceFingerprintCapacity();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+void RecipeLibrary::enforceFingerprintCapacity() {
+  while (fingerprint_memory_ > fingerprint_capacity_ && 
+         !fingerprint_usage_.empty()) {
+    FingerprintMap::iterator it = 
+      fingerprints_.find(*fingerprint_usage_.back());
+    fingerprint_usage_.pop_back();
+    fingerprint_memory_ -= approxMemory(it->first);
+    fingerprints_.erase(it);
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+long RecipeLibrary::approxMemory(const Fingerprint& print) {
+  // the composition and its nodes in the map and the usage list
+  long nodes = sizeof(FingerprintMap::value_type) + 7 * sizeof(void*);
+  return nodes + print.capacity() * sizeof(Fingerprint::value_type);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+Fingerprint RecipeLibrary::fingerprint(CompMapPtr recipe) {
+  Fingerprint print;
+  print.reserve(recipe->size());
+  for (CompMap::iterator it = recipe->begin(); it != recipe->end(); it++) {
+    double fraction = recipe->atomFraction(it->first);
+    if (fraction != 0) {
+      print.push_back(make_pair(it->first,fraction));
+    }
+  }
+  return print;
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RecipeLibrary::define_table() {
   // declare the state id columns and add it to the table
   iso_table->addField("ID","INTEGER");
-  iso_table->addField("IsoID","INTEGER");
-  iso_table->addField("Value","REAL");
-  // declare the table's primary key
   primary_key pk;
-  pk.push_back("ID"), pk.push_back("IsoID");
+  pk.push_back("ID");
+  if (blob_output_) {
+    // one row per composition
+    iso_table->addField("NIsos","INTEGER");
+    iso_table->addField("Compressed","INTEGER");
+    iso_table->addField("Composition","BLOB");
+  } else {
+    iso_table->addField("IsoID","INTEGER");
+    iso_table->addField("Value","REAL");
+    pk.push_back("IsoID");
+  }
+  // declare the table's primary key
   iso_table->setPrimaryKey(pk);
   // we've now defined the table
   iso_table->tableDefined();
@@ -240,32 +562,206 @@ void RecipeLibrary::addToTable(CompMapPtr recipe){
     RecipeLibrary::define_table();
   }
 
-  // make a row - stateid first then isotopics
-  // declare data
-  data an_id( recipe->ID() );
-  // declare entries
-  entry id("ID",an_id);
-
   // now for the composition isotopics
+  Fingerprint isos;
   for (CompMap::iterator item = recipe->begin();
        item != recipe->end(); item++) {
-    // declare row
-    // decalre data
-    data an_iso_id(item->first), an_iso_value(item->second);
-    // declare entries
-    entry iso_id("IsoID",an_iso_id), iso_value("Value",an_iso_value);
-    // construct row
-    row aRow;
-    aRow.push_back(id), aRow.push_back(iso_id), aRow.push_back(iso_value);
-    // add the row
-    iso_table->addRow(aRow);
-    // // record this primary key
-    // pkref_.push_back(id);
-    // pkref_.push_back(iso_id);
+    isos.push_back(make_pair(item->first,item->second));
   }
+  writeComposition(recipe->ID(),isos);
 }
 
 // //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // primary_key_ref RecipeLibrary::pkref() {
 //   return pkref_;
 // }
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RecipeLibrary::define_parent_table() {
+  iso_parent_table->addField("ID","INTEGER");
+  iso_parent_table->addField("ParentID","INTEGER");
+  iso_parent_table->addField("DecayTime","REAL");
+  primary_key pk;
+  pk.push_back("ID");
+  iso_parent_table->setPrimaryKey(pk);
+  iso_parent_table->tableDefined();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RecipeLibrary::writeComposition(int id, Fingerprint isos) {
+  data an_id(id);
+  entry id_entry("ID",an_id);
+  if (blob_output_) {
+    blob comp;
+    comp.bytes = encodeComposition(isos,compress_blobs_);
+    data n_isos(static_cast<int>(isos.size())), 
+      compressed(static_cast<int>(compress_blobs_)), a_comp(comp);
+    entry n_entry("NIsos",n_isos), compressed_entry("Compressed",compressed),
+      comp_entry("Composition",a_comp);
+    row aRow;
+    aRow.push_back(id_entry), aRow.push_back(n_entry), 
+      aRow.push_back(compressed_entry), aRow.push_back(comp_entry);
+    iso_table->addRow(aRow);
+    return;
+  }
+  for (Fingerprint::iterator it = isos.begin(); it != isos.end(); it++) {
+    data an_iso_id(it->first), an_iso_value(it->second);
+    entry iso_id("IsoID",an_iso_id), iso_value("Value",an_iso_value);
+    row aRow;
+    aRow.push_back(id_entry), aRow.push_back(iso_id), 
+      aRow.push_back(iso_value);
+    iso_table->addRow(aRow);
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RecipeLibrary::addCompactToTable(CompMapPtr recipe) {
+  if ( !iso_table->defined() ) {
+    RecipeLibrary::define_table();
+  }
+
+  Fingerprint print = fingerprint(recipe);
+  CompMapPtr parent = recipe->parent();
+  if (!parent || !parent->recorded() || !parent->normalized()) {
+    writeComposition(recipe->ID(),print);
+    return;
+  }
+
+  // only the isotopes that differ from the parent are written
+  if ( !iso_parent_table->defined() ) {
+    RecipeLibrary::define_parent_table();
+  }
+  data an_id(recipe->ID()), a_parent_id(parent->ID()), 
+    a_time(recipe->decay_time());
+  entry id("ID",an_id), parent_id("ParentID",a_parent_id), 
+    time("DecayTime",a_time);
+  row aRow;
+  aRow.push_back(id), aRow.push_back(parent_id), aRow.push_back(time);
+  iso_parent_table->addRow(aRow);
+
+  Fingerprint changed;
+  for (Fingerprint::iterator it = print.begin(); it != print.end(); it++) {
+    double parent_fraction = parent->atomFraction(it->first);
+    double tol = 1e-12 * max(it->second,parent_fraction);
+    if (fabs(it->second - parent_fraction) > tol) {
+      changed.push_back(*it);
+    }
+  }
+  for (CompMap::iterator it = parent->begin(); it != parent->end(); it++) {
+    if (it->second != 0 && recipe->atomFraction(it->first) == 0) {
+      changed.push_back(make_pair(it->first,0.0)); // removed from the parent
+    }
+  }
+  writeComposition(recipe->ID(),changed);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RecipeLibrary::setBlobOutput(bool blobs, bool compress) {
+  if (iso_table->defined() && blobs != blob_output_) {
+    throw CycOverrideException("The IsotopicStates layout can not be "
+                               "changed after it is defined.");
+  }
+  blob_output_ = blobs;
+  compress_blobs_ = compress;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RecipeLibrary::blobOutput() {
+  return blob_output_;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::string RecipeLibrary::encodeComposition(Fingerprint isos, bool compress) {
+  sort(isos.begin(),isos.end());
+  int n = isos.size();
+  string bytes;
+  bytes.reserve(4 + 12 * n);
+  // little endian, whatever the host
+  appendBytes(bytes,static_cast<uint32_t>(n),4);
+  for (int i = 0; i < n; i++) {
+    appendBytes(bytes,static_cast<uint32_t>(isos[i].first),4);
+  }
+  for (int i = 0; i < n; i++) {
+    uint64_t value;
+    memcpy(&value,&isos[i].second,8);
+    appendBytes(bytes,value,8);
+  }
+  if (!compress) {
+    return bytes;
+  }
+
+  uLongf size = compressBound(bytes.size());
+  vector<Bytef> buffer(size);
+  if (compress2(&buffer[0],&size,
+                reinterpret_cast<const Bytef*>(bytes.data()),bytes.size(),
+                Z_BEST_SPEED) != Z_OK) {
+    throw CycException("A composition could not be compressed.");
+  }
+  return string(reinterpret_cast<char*>(&buffer[0]),size);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Fingerprint RecipeLibrary::decodeComposition(const std::string& encoded, 
+                                             bool compressed) {
+  string bytes = encoded;
+  if (compressed) {
+    // the uncompressed size is in the header, so inflate in two steps
+    z_stream stream;
+    memset(&stream,0,sizeof(stream));
+    vector<Bytef> buffer(4);
+    stream.next_in = 
+      reinterpret_cast<Bytef*>(const_cast<char*>(encoded.data()));
+    stream.avail_in = encoded.size();
+    inflateInit(&stream);
+    stream.next_out = &buffer[0];
+    stream.avail_out = 4;
+    int status = inflate(&stream,Z_SYNC_FLUSH);
+    if (stream.avail_out == 0) {
+      uint32_t n = readBytes(string(buffer.begin(),buffer.end()),0,4);
+      buffer.resize(4 + 12 * static_cast<size_t>(n));
+      // past the header, which is the end of an empty composition
+      stream.next_out = &buffer[0] + 4;
+      stream.avail_out = buffer.size() - 4;
+      status = inflate(&stream,Z_FINISH);
+    }
+    inflateEnd(&stream);
+    if (status != Z_STREAM_END || stream.avail_out != 0) {
+      throw CycParseException("A composition could not be decompressed.");
+    }
+    bytes = string(buffer.begin(),buffer.end());
+  }
+
+  if (bytes.size() < 4) {
+    throw CycParseException("A composition blob is missing its size.");
+  }
+  size_t n = readBytes(bytes,0,4);
+  if (bytes.size() != 4 + 12 * n) {
+    throw CycParseException("A composition blob has the wrong size.");
+  }
+  Fingerprint isos(n);
+  for (size_t i = 0; i < n; i++) {
+    isos[i].first = static_cast<int>(readBytes(bytes,4 + 4 * i,4));
+    uint64_t value = readBytes(bytes,4 + 4 * n + 8 * i,8);
+    memcpy(&isos[i].second,&value,8);
+  }
+  return isos;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RecipeLibrary::appendBytes(std::string& bytes, uint64_t value, 
+                                int n_bytes) {
+  for (int i = 0; i < n_bytes; i++) {
+    bytes.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint64_t RecipeLibrary::readBytes(const std::string& bytes, size_t pos, 
+                                  int n_bytes) {
+  uint64_t value = 0;
+  for (int i = 0; i < n_bytes; i++) {
+    uint64_t byte = static_cast<unsigned char>(bytes[pos + i]);
+    value |= byte << (8 * i);
+  }
+  return value;
+}
@@ -8,6 +8,10 @@
 
 #include <set>
 #include <map>
+#include <list>
+#include <vector>
+#include <utility>
+#include <stdint.h>
 
 #define RL RecipeLibrary::Instance()
 
@@ -36,10 +40,70 @@ typedef std::map<double,CompMapPtr> ChildMap;
  */
 typedef std::map<CompMapPtr,ChildMap> DecayHistMap; 
 
+/**
+   map of decay time to the state ID given to the child at that time
+ */
+typedef std::map<double,int> ChildIDMap;
+
+/**
+   map of recipe composition to the state IDs of its decayed children
+ */
+typedef std::map<CompMapPtr,ChildIDMap> DecayIDMap;
+
+/**
+   a cached child, identified by its root recipe and total decay time
+ */
+typedef std::pair<CompMapPtr,double> DecayKey;
+
+/**
+   list of cached children, most recently used first
+ */
+typedef std::list<DecayKey> DecayUsageList;
+
+/**
+   map of a cached child to its position in the usage list
+ */
+typedef std::map<DecayKey,DecayUsageList::iterator> DecayUsageMap;
+
+/**
+   a composition as it is written to the output database, as pairs of 
+   isotope and atom fraction in isotope order
+ */
+typedef std::vector< std::pair<int,double> > Fingerprint;
+
+/**
+   the remembered compositions written to the output database, most 
+   recently used first
+ */
+typedef std::list<const Fingerprint*> FingerprintUsageList;
+
+/**
+   the state ID of a composition written to the output database and 
+   its position in the usage list
+ */
+struct WrittenComposition {
+  int id;
+  FingerprintUsageList::iterator usage;
+};
+
+/**
+   map of the compositions written to the output database to their 
+   state IDs
+ */
+typedef std::map<Fingerprint,WrittenComposition> FingerprintMap;
+
 /**
    The RecipeLibrary manages the list of recipes held in memory
    during a simulation. It works in conjunction with the CompMap
    class to efficiently manage isotopic-related memory.
+
+   Decayed children of recipes are cached so that materials sharing a
+   recipe only decay it once per decay time. The cache is bounded by
+   an approximate memory capacity; when it is exceeded, the least
+   recently used children are evicted and are simply recomputed if
+   they are needed again. The state ID given to a child is remembered
+   after eviction, so a recomputed child keeps the ID already written
+   to the output database.
  */
 class RecipeLibrary {
   /* --- Singleton Members and Methods --- */
@@ -141,13 +205,71 @@ class RecipeLibrary {
   static bool compositionDecayable(CompMapPtr comp);
 
   /**
-     checks if the parent has already been decayed by this time
+     checks if the parent has already been decayed by this time and the
+     child is still cached
 
      @param parent a pointer to the composition that might have a child
      @param time the time at which a child might exist for a parent
    */
   static bool childRecorded(CompMapPtr parent, double time);
 
+  /**
+     sets the approximate memory, in bytes, that cached decay children
+     may occupy. children are evicted immediately if the new capacity
+     is exceeded.
+
+     @param bytes the capacity of the decay cache
+   */
+  static void setDecayCacheCapacity(long bytes);
+
+  /**
+     the approximate memory, in bytes, that cached decay children may
+     occupy
+   */
+  static long decayCacheCapacity();
+
+  /**
+     the approximate memory, in bytes, occupied by cached decay children
+   */
+  static long decayCacheMemory();
+
+  /**
+     the number of decayed children currently cached
+   */
+  static int decayCacheSize();
+
+  /**
+     the number of decays served from the cache
+   */
+  static int decayCacheHits();
+
+  /**
+     the number of decays that had to be computed and were then cached
+   */
+  static int decayCacheMisses();
+
+  /**
+     the number of children evicted from the cache
+   */
+  static int decayCacheEvictions();
+
+  /**
+     decays every decayable recipe to each scheduled decay time of a
+     simulation, i.e. to every multiple of the decay interval up to its
+     duration, and caches the children so that the simulation only
+     looks them up. the decays are computed on a pool of threads and
+     then recorded, in order, on the calling thread. children that are
+     already cached are skipped.
+
+     @param duration the simulation duration, in months
+     @param interval the decay interval, in months. nothing is done if
+     it is not positive
+     @param n_threads the number of threads to use (default = 0, one
+     per hardware thread)
+   */
+  static void prewarmDecayCache(int duration, int interval,
+                                int n_threads = 0);
+
  private:
   /**
      adds recipe to containers tracking decayed recipes
@@ -195,6 +317,38 @@ class RecipeLibrary {
    */
   static void addChild(CompMapPtr parent, CompMapPtr child, double time);
 
+  /**
+     marks a cached child as the most recently used
+
+     @param parent the recipe whose child was used
+     @param time the time at which the child recipe of interest is indexed 
+   */
+  static void touchChild(CompMapPtr parent, double time);
+
+  /**
+     decays a recipe, as the simulation would, for 
+     prewarmDecayCache(). this only reads shared state once the first 
+     decay of the recipe has been done. 
+
+     @param key the recipe and the time to decay it for
+     @return the decayed recipe, or an empty pointer if it could not be 
+     decayed
+   */
+  static CompMapPtr decayRecipe(const DecayKey& key);
+
+  /**
+     evicts the least recently used children until the cache fits its
+     capacity. the most recently used child is never evicted.
+   */
+  static void enforceDecayCacheCapacity();
+
+  /**
+     the approximate memory, in bytes, held by a composition
+     
+     @param comp the composition whose footprint is estimated
+   */
+  static long approxMemory(CompMapPtr comp);
+
   /**
      calls recipeRecorded() and throws an error if false
 
@@ -237,12 +391,130 @@ class RecipeLibrary {
    */
   static DecayTimesMap decay_times_;
 
+  /**
+     the state IDs of all children ever recorded, kept after eviction
+   */
+  static DecayIDMap decay_ids_;
+
+  /**
+     the cached children ordered by use, most recent first
+   */
+  static DecayUsageList decay_usage_;
+
+  /**
+     the position of each cached child in decay_usage_
+   */
+  static DecayUsageMap decay_usage_index_;
+
+  /**
+     the approximate memory, in bytes, that cached children may occupy
+   */
+  static long decay_cache_capacity_;
+
+  /**
+     the approximate memory, in bytes, occupied by cached children
+   */
+  static long decay_cache_memory_;
+
+  /**
+     decay cache statistics
+   */
+  static int decay_cache_hits_;
+  static int decay_cache_misses_;
+  static int decay_cache_evictions_;
+
  /* -- Output Database Interaction  -- */ 
  public:
   /**
      the isotopics output database Table 
    */
   static table_ptr iso_table;
+
+  /**
+     the output database Table of the parents that compact 
+     compositions are written against 
+   */
+  static table_ptr iso_parent_table;
+
+  /**
+     sets whether compositions are written compactly. compact 
+     compositions are written as atom fractions; a composition that was 
+     already written, and is still remembered, is given the existing 
+     state ID instead of being written again, and a composition whose parent was written (e.g. a 
+     decayed recipe) is written as a row in iso_parent_table and only 
+     the isotopes whose fractions differ from its parent's, by more 
+     than 1e-12 relative, with removed isotopes given a fraction of 0. 
+
+     @param compact true to write compactly (default = false) 
+   */
+  static void setCompactOutput(bool compact);
+
+  /**
+     returns true if compositions are written compactly 
+   */
+  static bool compactOutput();
+
+  /**
+     sets the approximate memory, in bytes, that the compositions 
+     remembered for compact output may occupy. the least recently used 
+     are forgotten once it is exceeded, and are simply written again 
+     under a new state ID if they recur.
+
+     @param bytes the capacity of the remembered compositions
+   */
+  static void setFingerprintCapacity(long bytes);
+
+  /**
+     the approximate memory, in bytes, that the compositions remembered 
+     for compact output may occupy
+   */
+  static long fingerprintCapacity();
+
+  /**
+     the approximate memory, in bytes, occupied by the compositions 
+     remembered for compact output
+   */
+  static long fingerprintMemory();
+
+  /**
+     sets the layout of the isotopics table. by default a composition 
+     is written as a row per isotope, (ID, IsoID, Value). the blob 
+     layout writes it as a single row, (ID, NIsos, Compressed, 
+     Composition), whose Composition blob is encoded by 
+     encodeComposition(). output/output_tools.py decodes either layout. 
+
+     @param blobs true to write a blob per composition (default = false) 
+     @param compress true to compress the blobs with zlib 
+     @throws CycOverrideException if the table has already been defined 
+     in the other layout 
+   */
+  static void setBlobOutput(bool blobs, bool compress = false);
+
+  /**
+     returns true if each composition is written as a single blob row 
+   */
+  static bool blobOutput();
+
+  /**
+     encodes a composition as a blob: the number of isotopes as a 
+     uint32, the isotope IDs in ascending order as int32s, and their 
+     values as float64s, all little endian. compressed blobs are this 
+     encoding deflated by zlib. 
+
+     @param isos the isotopes and their values 
+     @param compress true to compress the blob 
+   */
+  static std::string encodeComposition(Fingerprint isos, bool compress);
+
+  /**
+     decodes a blob written by encodeComposition() 
+
+     @param bytes the blob 
+     @param compressed true if the blob was compressed 
+     @throws CycParseException if the blob is malformed 
+   */
+  static Fingerprint decodeComposition(const std::string& bytes, 
+                                       bool compressed);
   
   /* /\** */
   /*    return the agent table's primary key  */
@@ -265,6 +537,94 @@ class RecipeLibrary {
    */
   static void addToTable(CompMapPtr recipe);
 
+  /**
+     Define the parent database table on the first compact composition 
+     written against a parent 
+   */
+  static void define_parent_table();
+
+  /**
+     Add an isotopic state to the tables compactly, i.e. as only its 
+     differences from its parent if the parent was recorded 
+   */
+  static void addCompactToTable(CompMapPtr recipe);
+
+  /**
+     returns the composition as written in compact form 
+   */
+  static Fingerprint fingerprint(CompMapPtr recipe);
+
+  /**
+     remembers a composition written compactly, forgetting the least 
+     recently used ones if the capacity is exceeded 
+
+     @param print the composition as written 
+     @param id its state ID 
+   */
+  static void rememberFingerprint(const Fingerprint& print, int id);
+
+  /**
+     forgets the least recently used compositions until the remembered 
+     ones fit their capacity 
+   */
+  static void enforceFingerprintCapacity();
+
+  /**
+     the approximate memory, in bytes, held by a remembered composition 
+
+     @param print the composition whose footprint is estimated 
+   */
+  static long approxMemory(const Fingerprint& print);
+
+  /**
+     writes a composition's isotopes to the isotopics table, as a row 
+     per isotope or as a single blob row 
+   */
+  static void writeComposition(int id, Fingerprint isos);
+
+  /**
+     appends the n_bytes low bytes of value to bytes, little endian 
+   */
+  static void appendBytes(std::string& bytes, uint64_t value, int n_bytes);
+
+  /**
+     reads n_bytes little endian bytes from bytes, starting at pos 
+   */
+  static uint64_t readBytes(const std::string& bytes, size_t pos, 
+                            int n_bytes);
+
+  /**
+     true if each composition is written as a single blob row 
+   */
+  static bool blob_output_;
+
+  /**
+     true if blobs are compressed 
+   */
+  static bool compress_blobs_;
+
+  /**
+     true if compositions are written compactly 
+   */
+  static bool compact_output_;
+
+  /**
+     the compositions written compactly that are remembered 
+   */
+  static FingerprintMap fingerprints_;
+
+  /**
+     the remembered compositions, most recently used first 
+   */
+  static FingerprintUsageList fingerprint_usage_;
+
+  /**
+     the approximate memory, in bytes, the remembered compositions may 
+     occupy and do occupy 
+   */
+  static long fingerprint_capacity_;
+  static long fingerprint_memory_;
+
   /* /\** */
   /*    Store information about the transactions's primary key  */
   /*  *\/ */
@@ -1,6 +1,7 @@
 #include "SupplyDemandManager.h"
 
 #include "CycException.h"
+#include "Timer.h"
 
 using namespace std;
 using namespace SupplyDemand;
@@ -64,6 +65,18 @@ FunctionPtr SupplyDemandManager::demandFunction(Commodity& commodity)
   return demand_functions_[commodity];
 }
 
+// -------------------------------------------------------------------
+void SupplyDemandManager::tabulateDemand() 
+{
+  int begin = TI->finalTime() - TI->simDur();
+  int n = TI->simDur() + 1;
+  map<Commodity,FunctionPtr,CommodityCompare>::iterator it;
+  for (it = demand_functions_.begin(); it != demand_functions_.end(); it++) 
+    {
+      it->second = FunctionPtr(new TabulatedFunction(it->second,begin,n));
+    }
+}
+
 // -------------------------------------------------------------------
 void SupplyDemandManager::throwErrorIfCommodityNotManaged(Commodity& commodity)
 {
@@ -75,6 +75,13 @@ class SupplyDemandManager {
    */
   FunctionPtr demandFunction(Commodity& commodity);
 
+  /**
+     replaces the demand function of each commodity with a table of 
+     its values at each time of the simulation, as set by the Timer, 
+     so that demand() looks them up rather than evaluating them
+   */
+  void tabulateDemand();
+
   // protected: @MJGFlag - should be protected. revise when tests can
   // be found by classes in the Utility folder
   /**
@@ -1,6 +1,7 @@
 #include "SymbolicFunctions.h"
 
 #include <math.h>
+#include <algorithm>
 #include <string>
 #include <sstream>
 #include <limits>
@@ -8,6 +9,15 @@
 using namespace std;
 using namespace boost;
 
+// -------------------------------------------------------------------
+void Function::values(const double* x, double* y, int n) 
+{
+  for (int i = 0; i < n; i++)
+    {
+      y[i] = value(x[i]);
+    }
+}
+
 // -------------------------------------------------------------------
 double LinearFunction::value(double x) 
 { 
@@ -40,19 +50,48 @@ std::string ExponentialFunction::print()
 // -------------------------------------------------------------------
 double PiecewiseFunction::value(double x) 
 {
-  double ret;
-  if ( functions_.empty() || ( x < functions_.front().xoffset) ) 
+  int i = piece(x);
+  if (i < 0) 
     {
-      ret = 0.0;
+      return 0.0;
     }
-  else 
+  const PiecewiseFunctionInfo& f = functions_[i];
+  return f.function->value(x - f.xoffset) + f.yoffset;
+}
+
+// -------------------------------------------------------------------
+void PiecewiseFunction::values(const double* x, double* y, int n) 
+{
+  int i = -1;
+  for (int j = 0; j < n; j++)
     {
-      list<PiecewiseFunctionInfo>::iterator f = functions_.begin();
-      while ( f != functions_.end() && (x >= f->xoffset) ) ++f; // exceeds search by 1
-      --f; // go back to the correct one
-      ret = f->function->value(x - f->xoffset) + f->yoffset;
+      i = piece(x[j], (j > 0 && x[j] >= x[j-1] && i > 0) ? i : 0);
+      if (i < 0) 
+        {
+          y[j] = 0.0;
+        }
+      else 
+        {
+          const PiecewiseFunctionInfo& f = functions_[i];
+          y[j] = f.function->value(x[j] - f.xoffset) + f.yoffset;
+        }
     }
-  return ret;
+}
+
+// -------------------------------------------------------------------
+int PiecewiseFunction::piece(double x, int from) 
+{
+  // the first piece starting after x follows the one x falls in
+  vector<double>::iterator after = 
+    upper_bound(starts_.begin() + from, starts_.end(), x);
+  return (after - starts_.begin()) - 1;
+}
+
+// -------------------------------------------------------------------
+void PiecewiseFunction::addPiece(const PiecewiseFunctionInfo& info) 
+{
+  functions_.push_back(info);
+  starts_.push_back(info.xoffset);
 }
   
 // -------------------------------------------------------------------
@@ -60,7 +99,7 @@ std::string PiecewiseFunction::print()
 { 
   stringstream ss("");
   ss << "Piecewise Function comprised of: ";
-  list<PiecewiseFunctionInfo>::iterator f;
+  vector<PiecewiseFunctionInfo>::iterator f;
   for (f = functions_.begin(); f != functions_.end(); f++)
     {
       ss << " * " << f->function->print() 
@@ -69,3 +108,38 @@ std::string PiecewiseFunction::print()
     }
   return ss.str();
 }
+
+// -------------------------------------------------------------------
+TabulatedFunction::TabulatedFunction(FunctionPtr function, int begin, int n) : 
+  function_(function), begin_(begin), table_(n,0.0)
+{
+  if (n > 0) 
+    {
+      vector<double> x(n);
+      for (int i = 0; i < n; i++)
+        {
+          x[i] = begin + i;
+        }
+      function_->values(&x[0],&table_[0],n);
+    }
+}
+
+// -------------------------------------------------------------------
+double TabulatedFunction::value(double x) 
+{
+  double i = x - begin_;
+  if (i >= 0 && i < table_.size() && i == floor(i)) 
+    {
+      return table_[static_cast<int>(i)];
+    }
+  return function_->value(x);
+}
+
+// -------------------------------------------------------------------
+std::string TabulatedFunction::print() 
+{ 
+  stringstream ss("");
+  ss << "Table of " << table_.size() << " values from x = " << begin_
+     << " of: " << function_->print();
+  return ss.str();
+}
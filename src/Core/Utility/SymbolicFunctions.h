@@ -2,7 +2,7 @@
 #define SYMBOLICFUNCTIONS_H
 
 #include <string>
-#include <list>
+#include <vector>
 #include <boost/shared_ptr.hpp>
 
 // forward declarations
@@ -10,6 +10,7 @@ class Function;
 class LinearFunction;
 class ExponentialFunction;
 class PiecewiseFunction;
+class TabulatedFunction;
 
 // typedefs
 typedef boost::shared_ptr<Function> FunctionPtr;
@@ -27,6 +28,14 @@ class Function
   /// base class must define how to calculate demand (dbl argument)
   virtual double value(double x) = 0; 
 
+  /**
+     evaluation for an array of arguments, by default value() of each
+     @param x the arguments
+     @param y filled with the value at each argument
+     @param n the number of arguments
+   */
+  virtual void values(const double* x, double* y, int n);
+
   /// every function must print itself
   virtual std::string print() = 0;
 };
@@ -97,6 +106,9 @@ class ExponentialFunction : public Function
    piecewise function
    f(x) for all x in [lhs,rhs]
    0 otherwise
+
+   the starting coordinates of the pieces are kept in a sorted array 
+   that is binary searched for the piece of an argument
  */
 class PiecewiseFunction : public Function 
 {
@@ -111,14 +123,69 @@ class PiecewiseFunction : public Function
  public:
   /// evaluation for an double argument
   virtual double value(double x);
+
+  /**
+     evaluation for an array of arguments. arguments in ascending order
+     are found by searching only the pieces after the last one found
+   */
+  virtual void values(const double* x, double* y, int n);
   
   /// print a string of the function
   virtual std::string print();
   
  private:
-  std::list<PiecewiseFunctionInfo> functions_;
+  /**
+     the position of the piece an argument falls in, searching from
+     a given position, or -1 if it falls before the first piece
+   */
+  int piece(double x, int from = 0);
+
+  /// append a piece to the function
+  void addPiece(const PiecewiseFunctionInfo& info);
+
+  /// the pieces of the function
+  std::vector<PiecewiseFunctionInfo> functions_;
+
+  /// the starting coordinate of each piece, in ascending order
+  std::vector<double> starts_;
 
   friend class PiecewiseFunctionFactory;
 };
 
+/**
+   tabulated function
+   f(x) = g(x), looked up in a table for integer x in [begin,begin+n)
+   and evaluated otherwise
+
+   demand functions are evaluated at each time step, so tabulating 
+   them over the simulation turns an evaluation into a lookup
+ */
+class TabulatedFunction : public Function 
+{
+ public:
+  /**
+     constructor for a tabulated function
+     @param function the function to tabulate, g(x)
+     @param begin the first integer argument in the table
+     @param n the number of arguments in the table
+   */
+  TabulatedFunction(FunctionPtr function, int begin, int n);
+
+  /// evaluation for a double argument
+  virtual double value(double x);
+
+  /// print a string of the function
+  virtual std::string print();
+
+ private:
+  /// the tabulated function
+  FunctionPtr function_;
+
+  /// the first integer argument in the table
+  int begin_;
+
+  /// the value at each integer argument from begin_
+  std::vector<double> table_;
+};
+
 #endif
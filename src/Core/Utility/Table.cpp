@@ -1,4 +1,5 @@
 #include <iostream>
+#include <cstdlib>
 
 #include "Table.h"
 
@@ -89,6 +90,35 @@ string Table::create(){
   return cmd.str();
 }
 
+// -----------------------------------------------------------------------
+std::ostream& operator<<(std::ostream& os, const blob& b) {
+  static const char* hex = "0123456789ABCDEF";
+  os << "X'";
+  for (string::const_iterator it = b.bytes.begin(); 
+       it != b.bytes.end(); it++) {
+    unsigned char byte = static_cast<unsigned char>(*it);
+    os << hex[byte >> 4] << hex[byte & 0xf];
+  }
+  return os << "'";
+}
+
+// -----------------------------------------------------------------------
+std::istream& operator>>(std::istream& is, blob& b) {
+  string literal;
+  is >> literal;
+  if (literal.size() < 3 || literal[0] != 'X' || literal[1] != '\'' || 
+      literal[literal.size() - 1] != '\'' || literal.size() % 2 == 0) {
+    is.setstate(std::ios::failbit);
+    return is;
+  }
+  b.bytes.clear();
+  for (size_t i = 2; i + 1 < literal.size(); i += 2) {
+    b.bytes.push_back(static_cast<char>(
+        strtol(literal.substr(i,2).c_str(),NULL,16)));
+  }
+  return is;
+}
+
 // -----------------------------------------------------------------------
 string Table::stringifyData(data const d){
   command data("");
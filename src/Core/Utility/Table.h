@@ -4,6 +4,7 @@
 #include <string>
 #include <sstream>
 #include <vector>
+#include <iostream>
 #include <boost/intrusive_ptr.hpp>
 #include <boost/spirit/home/support/detail/hold_any.hpp>
 #include <boost/shared_ptr.hpp>
@@ -23,6 +24,14 @@ typedef std::string data_type;
 typedef std::pair<col_name, data_type> column;
 //   Rows
 typedef boost::spirit::hold_any data;
+/**
+   binary data, held in a data entry and written as an SQL blob literal 
+ */
+struct blob {
+  std::string bytes;
+};
+std::ostream& operator<<(std::ostream& os, const blob& b);
+std::istream& operator>>(std::istream& is, blob& b);
 typedef std::pair<col_name,data> entry;
 typedef std::vector<entry> row;
 //   Keys
@@ -5,6 +5,8 @@
 
 #include <string>
 #include <iostream>
+#include <algorithm>
+#include <boost/thread.hpp>
 
 #include "CycException.h"
 #include "Logger.h"
@@ -14,6 +16,48 @@ using namespace std;
 
 Timer* Timer::instance_ = 0;
 
+namespace {
+  /**
+     The matching step of Timer::sendResolve(), run on each resolve 
+     thread or directly when there is only one. Each worker takes the 
+     next market from the resolve listeners and matches it, until none 
+     are left. Errors are kept to be logged once the workers are done. 
+   */
+  class MatchWorker {
+   public:
+    MatchWorker(vector<MarketModel*>& markets, vector<string>& errors, 
+                int& next_market, boost::mutex& lock) 
+      : markets_(markets), errors_(errors), next_market_(next_market), 
+        lock_(lock) {}
+
+    void operator()() {
+      while (true) {
+        int market;
+        {
+          boost::mutex::scoped_lock guard(lock_);
+          if (next_market_ >= (int)markets_.size()) {
+            return;
+          }
+          market = next_market_++;
+        }
+        try {
+          markets_[market]->match();
+        } catch(const std::exception& err) {
+          errors_[market] = err.what();
+        } catch(...) {
+          errors_[market] = "unknown error in match()";
+        }
+      }
+    }
+
+   private:
+    vector<MarketModel*>& markets_;
+    vector<string>& errors_;
+    int& next_market_;
+    boost::mutex& lock_;
+  };
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Timer::runSim() {
   CLOG(LEV_INFO1) << "Simulation set to run from start="
@@ -48,9 +92,7 @@ void Timer::runSim() {
   int count = 0;
   while (Model::getModelList().size() > 0) {
     Model* model = Model::getModelList().at(count);
-    try {
-      model->parent();
-    } catch (CycIndexException err) {
+    if (model->tryParent() == NULL) {
       delete model;
       count = 0;
       continue;
@@ -79,13 +121,31 @@ string Timer::reportListeners() {
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Timer::sendResolve() {
-  for(vector<MarketModel*>::iterator agent=resolve_listeners_.begin();
-       agent != resolve_listeners_.end(); 
-       agent++) {
+  int n_markets = resolve_listeners_.size();
+  vector<string> errors(n_markets);
+  int n_threads = min(resolve_threads_,n_markets);
+  int next_market = 0;
+  boost::mutex lock;
+  MatchWorker worker(resolve_listeners_,errors,next_market,lock);
+  if (n_threads > 1) {
+    boost::thread_group threads;
+    for (int i = 0; i < n_threads; i++) {
+      threads.create_thread(worker);
+    }
+    threads.join_all();
+  } else {
+    worker();
+  }
+
+  for (int i = 0; i < n_markets; i++) {
+    MarketModel* agent = resolve_listeners_.at(i);
     try {
-      CLOG(LEV_INFO3) << "Sending resolve to Model ID=" << (*agent)->ID()
-                      << ", name=" << (*agent)->name() << " {";
-      (*agent)->resolve();
+      CLOG(LEV_INFO3) << "Sending resolve to Model ID=" << agent->ID()
+                      << ", name=" << agent->name() << " {";
+      if (!errors.at(i).empty()) {
+        throw CycException(errors.at(i));
+      }
+      agent->resolve();
     } catch(CycException err) {
       CLOG(LEV_ERROR) << "ERROR occured in sendResolve(): " << err.what();
     }
@@ -93,6 +153,19 @@ void Timer::sendResolve() {
   }
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Timer::setResolveThreads(int n_threads) {
+  if (n_threads <= 0) {
+    n_threads = max(1, (int)boost::thread::hardware_concurrency());
+  }
+  resolve_threads_ = n_threads;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int Timer::resolveThreads() {
+  return resolve_threads_;
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Timer::sendTick() {
   for(vector<TimeAgent*>::iterator agent=tick_listeners_.begin();
@@ -214,6 +287,7 @@ int Timer::simDur() {
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Timer::Timer() {
   time_ = 0;
+  resolve_threads_ = 1;
 }
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -83,10 +83,9 @@ class Timer {
   std::vector<MarketModel*> resolve_listeners_;
 
   /**
-     sends the resolve signal to all of the (market) models receiving 
-     resolve notifications. 
+     The number of threads on which markets match 
    */
-  void sendResolve();
+  int resolve_threads_;
 
   /**
      sends the tick signal to all of the models receiving time 
@@ -110,6 +109,15 @@ protected:
      Constructs a new Timer for this simulation. 
    */
   Timer();
+
+  /**
+     sends the resolve signal to all of the (market) models receiving 
+     resolve notifications. The markets first match, concurrently if 
+     there are resolve threads to spare, and then resolve one after 
+     another in registration order, so that transactions are created 
+     in the same order however many threads there are. 
+   */
+  void sendResolve();
   
 public:
   /**
@@ -153,6 +161,19 @@ public:
    */
   void registerResolveListener(MarketModel* agent);
 
+  /**
+     sets the number of threads on which markets match each month 
+
+     @param n_threads the number of threads, or 0 for one per core 
+     (default = 1) 
+   */
+  void setResolveThreads(int n_threads);
+
+  /**
+     returns the number of threads on which markets match 
+   */
+  int resolveThreads();
+
   /**
      Returns the current time, in months since the simulation started. 
       
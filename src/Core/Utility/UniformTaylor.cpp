@@ -9,6 +9,16 @@
 
 using namespace std;
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Vector UniformTaylor::solve(const Matrix & A, const Vector & x_o, double t) {
+  return matrixExpSolver(A, x_o, t);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Matrix UniformTaylor::propagator(const Matrix & A, double t) {
+  return matrixExp(A, t);
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Vector UniformTaylor::matrixExpSolver(const Matrix & A,
     const Vector & x_o, const double t)
@@ -39,6 +49,53 @@ Vector UniformTaylor::matrixExpSolver(const Matrix & A,
   return x_t;
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Matrix UniformTaylor::matrixExp(const Matrix & A, const double t) {
+  int n = A.numRows();
+  
+  // scales tA by 2^-s so that its norm is no larger than 1/2
+  long double norm = fabs(t) * maxAbsRowSum(A);
+  int s = 0;
+  while ( norm > 0.5 ) {
+    norm /= 2;
+    ++s;
+  }
+  Matrix X = (t / pow(2.0L, s)) * A;
+
+  // sums the Taylor Series until the terms no longer change the sum
+  Matrix expX = identity(n);
+  Matrix term = identity(n);
+  long double term_norm = 1;
+  for ( int k = 1; term_norm > 1e-30 && k < 100; ++k ) {
+    term *= X;
+    term = (1.0L / k) * term;
+    expX += term;
+    term_norm = maxAbsRowSum(term);
+  }
+  
+  // undoes the scaling: e^(tA) = (e^X)^(2^s)
+  for ( int i = 0; i < s; ++i ) {
+    expX *= expX;
+  }
+
+  return expX;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+long double UniformTaylor::maxAbsRowSum(const Matrix & A) {
+  long double max_sum = 0;
+  for ( int i = 1; i <= A.numRows(); ++i ) {
+    long double sum = 0;
+    for ( int j = 1; j <= A.numCols(); ++j ) {
+      sum += fabs(A(i,j));
+    }
+    if ( sum > max_sum ) {
+      max_sum = sum;
+    }
+  }
+  return max_sum;
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 double UniformTaylor::maxAbsDiag(const Matrix & A) {
   int n = A.numRows();       // stores the order of the matrix A    
@@ -3,6 +3,7 @@
 #define UNIFORMTAYLOR_H
 
 #include "UseMatrixLib.h"
+#include "DecaySolver.h"
 
 /**
    @class UniformTaylor 
@@ -10,9 +11,19 @@
    A class that solves the matrix exponential 
    problem using the Taylor Series with Uniformization method. 
  */
-class UniformTaylor {
+class UniformTaylor : public DecaySolver {
 
   public:
+    /**
+       DecaySolver interface, calls matrixExpSolver()
+     */
+    virtual Vector solve(const Matrix & A, const Vector & x_o, double t);
+
+    /**
+       DecaySolver interface, calls matrixExp() 
+     */
+    virtual Matrix propagator(const Matrix & A, double t);
+
     /**
        Solves the matrix exponential problem: 
         
@@ -35,6 +46,19 @@ class UniformTaylor {
                                   const Vector & x_o,
 				  const double t);
 
+    /**
+       Computes the matrix exponential e^(tA) itself by scaling and 
+       squaring: tA is halved until its norm is small, the Taylor 
+       Series of the scaled matrix is summed to full precision, and the 
+       result is squared back. Unlike matrixExpSolver(), the accuracy 
+       does not degrade when the result is raised to large powers. 
+        
+       @param A the Matrix 
+       @param t the value for which the exponential is being evaluated 
+       @return the Matrix e^(tA) 
+     */
+    static Matrix matrixExp(const Matrix & A, const double t);
+
   private:
     /**
        Returns the diagonal element in the Matrix A 
@@ -45,6 +69,15 @@ class UniformTaylor {
      */
     static double maxAbsDiag(const Matrix & A);
 
+    /**
+       Returns the largest sum of absolute values in a row of the 
+       Matrix A, i.e. its infinity norm. 
+        
+       @param A the Matrix 
+       @return the infinity norm of A 
+     */
+    static long double maxAbsRowSum(const Matrix & A);
+
     /**
        Computes the solution Vector x_t using the Taylor Series with 
        Uniformization method. 
@@ -82,3 +82,25 @@ TEST_F(BuildingManagerTests,emptyorder)
   vector<BuildOrder> orders = manager.makeBuildDecision(helper->commodity,0);
   EXPECT_TRUE(orders.empty());
 }
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(BuildingManagerTests,repeateddecision) 
+{
+  setUpProblem();
+  vector<BuildOrder> first = manager.makeBuildDecision(helper->commodity,demand);
+  vector<BuildOrder> second = manager.makeBuildDecision(helper->commodity,demand);
+  ASSERT_EQ(second.size(),first.size());
+  for (int i = 0; i < first.size(); i++)
+    {
+      EXPECT_EQ(second.at(i).number,first.at(i).number);
+      EXPECT_EQ(second.at(i).builder,first.at(i).builder);
+      EXPECT_EQ(second.at(i).producer,first.at(i).producer);
+    }
+
+  // a change in capacity must be seen by the next decision
+  helper->producer2->setCapacity(helper->commodity,demand);
+  vector<BuildOrder> orders = manager.makeBuildDecision(helper->commodity,demand);
+  ASSERT_EQ(orders.size(),1);
+  EXPECT_EQ(orders.at(0).number,1);
+  EXPECT_EQ(orders.at(0).producer,helper->producer2);
+}
@@ -68,3 +68,26 @@ TEST_F(CommodityProducerManagerTests,differentcommodity)
   Commodity differentcommodity("differentcommodity");
   EXPECT_EQ(manager.totalProductionCapacity(differentcommodity),0.0);
 }
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(CommodityProducerManagerTests,capacitychanges)
+{
+  EXPECT_NO_THROW(registerProducer(helper->producer1));
+  EXPECT_NO_THROW(registerProducer(helper->producer2));
+
+  helper->producer1->setCapacity(helper->commodity,2*helper->capacity);
+  EXPECT_EQ(manager.totalProductionCapacity(helper->commodity),3*helper->capacity);
+
+  // a commodity added after registration
+  Commodity differentcommodity("differentcommodity");
+  helper->producer2->addCommodity(differentcommodity);
+  helper->producer2->setCapacity(differentcommodity,helper->capacity);
+  EXPECT_EQ(manager.totalProductionCapacity(differentcommodity),helper->capacity);
+
+  // a destroyed producer is unregistered
+  delete helper->producer2;
+  helper->producer2 = new CommodityProducer();
+  EXPECT_EQ(manager.totalProductionCapacity(helper->commodity),2*helper->capacity);
+  EXPECT_EQ(manager.totalProductionCapacity(differentcommodity),0.0);
+  EXPECT_THROW(unRegisterProducer(helper->producer2),CycNotRegisteredException);
+}
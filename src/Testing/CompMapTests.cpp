@@ -90,3 +90,24 @@ TEST_F(CompMapTests,equality) {
   CompMap copy = CompMap(comp_);
   EXPECT_TRUE(copy == comp_);
 }
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+TEST_F(CompMapTests,fraction_queries_keep_basis) {
+  LoadMap();
+  comp_.setMap(map_);
+  comp_.normalize();
+  for (Map::iterator it = map_.begin(); it != map_.end(); it++) {
+    EXPECT_DOUBLE_EQ(atomified_[it->first],comp_.atomFraction(it->first));
+    EXPECT_EQ(MASS,comp_.basis());
+  }
+  EXPECT_EQ(massified_,comp_.map());
+  // the cached atom basis is used and the old mass basis kept
+  comp_.atomify();
+  comp_.massify();
+  EXPECT_EQ(massified_,comp_.map());
+  // altering the composition invalidates the cached basis
+  comp_[isotopes_.at(0)] = 0;
+  comp_.normalize();
+  EXPECT_DOUBLE_EQ(0,comp_.atomFraction(isotopes_.at(0)));
+  EXPECT_DOUBLE_EQ(1,comp_.atomFraction(isotopes_.at(1)));
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "CoverSolver.h"
+
+using namespace std;
+using namespace ActionBuilding;
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+/// the cheapest cover found by trying every number up to a limit
+double bruteForceCost(const vector<double>& capacities, 
+                      const vector<double>& costs,
+                      double demand, vector<int>& numbers, int i,
+                      int limit) 
+{
+  if (i == capacities.size()) 
+    {
+      double capacity = 0, cost = 0;
+      for (int j = 0; j < i; j++) 
+        {
+          capacity += numbers[j] * capacities[j];
+          cost += numbers[j] * costs[j];
+        }
+      return capacity >= demand ? cost : 1e300;
+    }
+  double best = 1e300;
+  for (int n = 0; n <= limit; n++) 
+    {
+      numbers[i] = n;
+      double cost = bruteForceCost(capacities,costs,demand,numbers,i + 1,limit);
+      if (cost < best) 
+        {
+          best = cost;
+        }
+    }
+  numbers[i] = 0;
+  return best;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+double coverCost(const vector<double>& capacities, 
+                 const vector<double>& costs,
+                 double demand, const vector<int>& numbers) 
+{
+  double capacity = 0, cost = 0;
+  for (int i = 0; i < numbers.size(); i++) 
+    {
+      capacity += numbers[i] * capacities[i];
+      cost += numbers[i] * costs[i];
+    }
+  EXPECT_GE(capacity,demand);
+  return cost;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(CoverSolverTests,buildingproblem) 
+{
+  // the problem of the BuildingManager tests, which ties 1x800 + 2x200
+  // with 6x200; the fewer, larger builds are preferred
+  vector<double> capacities, costs;
+  capacities.push_back(800), costs.push_back(800);
+  capacities.push_back(200), costs.push_back(200);
+  vector<int> numbers;
+  CoverSolver solver;
+  ASSERT_TRUE(solver.solve(capacities,costs,1001,numbers));
+  ASSERT_EQ(numbers.size(),2);
+  EXPECT_EQ(numbers.at(0),1);
+  EXPECT_EQ(numbers.at(1),2);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(CoverSolverTests,nodemand) 
+{
+  vector<double> capacities(2,100), costs(2,10);
+  vector<int> numbers;
+  CoverSolver solver;
+  ASSERT_TRUE(solver.solve(capacities,costs,0,numbers));
+  EXPECT_EQ(numbers,vector<int>(2,0));
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(CoverSolverTests,leftoverproblems) 
+{
+  vector<double> capacities(1,100), costs(1,-1);
+  vector<int> numbers;
+  CoverSolver solver;
+  EXPECT_FALSE(solver.solve(capacities,costs,50,numbers));
+
+  // no capacity can meet the demand
+  capacities.at(0) = 0, costs.at(0) = 1;
+  EXPECT_FALSE(solver.solve(capacities,costs,50,numbers));
+
+  // too many branches
+  CoverSolver small(3);
+  capacities.at(0) = 1;
+  EXPECT_FALSE(small.solve(capacities,costs,50,numbers));
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(CoverSolverTests,matchesbruteforce) 
+{
+  srand(12345);
+  CoverSolver solver;
+  for (int trial = 0; trial < 200; trial++) 
+    {
+      int n = 1 + rand() % 4;
+      vector<double> capacities, costs;
+      for (int i = 0; i < n; i++) 
+        {
+          capacities.push_back(10 + rand() % 41);
+          costs.push_back(1 + rand() % 50);
+        }
+      // no more than 10 of any type are ever needed
+      double demand = 1 + rand() % 100;
+
+      vector<int> numbers, tried(n,0);
+      ASSERT_TRUE(solver.solve(capacities,costs,demand,numbers));
+      EXPECT_DOUBLE_EQ(coverCost(capacities,costs,demand,numbers),
+                       bruteForceCost(capacities,costs,demand,tried,0,10));
+    }
+}
@@ -1,2 +1,276 @@
-// empty so far
+// DecayHandlerTests.cpp
+#include <gtest/gtest.h>
 
+#include "DecayHandler.h"
+#include "UniformTaylor.h"
+#include "BatemanSolver.h"
+#include "CramSolver.h"
+#include "CycException.h"
+
+#include <cmath>
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// a Bateman solver that counts the times it is used
+class CountingSolver : public BatemanSolver {
+ public:
+  CountingSolver() : calls(0) {};
+  virtual Vector solve(const Matrix & A, const Vector & x_o, double t) {
+    calls++;
+    return BatemanSolver::solve(A, x_o, t);
+  }
+  int calls;
+};
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class DecayHandlerTest : public ::testing::Test {
+  protected:
+    Matrix chain_;
+    Vector x_o_;
+    double lambda_a_, lambda_b_;
+    CompMapPtr comp_;
+
+    virtual void SetUp() {
+      // a -> b -> c, where c is stable
+      lambda_a_ = 0.5;
+      lambda_b_ = 2.0;
+      chain_ = Matrix(3,3);
+      chain_(1,1) = -lambda_a_;
+      chain_(2,1) = lambda_a_;
+      chain_(2,2) = -lambda_b_;
+      chain_(3,2) = lambda_b_;
+      x_o_ = Vector(3,1);
+      x_o_(1,1) = 1;
+
+      // u235 and its daughters with an untracked stable isotope
+      comp_ = CompMapPtr(new CompMap(ATOM));
+      (*comp_)[92235] = 0.5;
+      (*comp_)[94239] = 0.25;
+      (*comp_)[1001] = 0.25;
+      comp_->normalize();
+    }
+
+    virtual void TearDown() {
+      DecayHandler::setSolver(DecaySolverPtr(new UniformTaylor()));
+      DecayHandler::setPropagatorInterval(0);
+    }
+
+    double a(double t) { 
+      return exp(-lambda_a_ * t); 
+    }
+
+    double b(double t) { 
+      return lambda_a_ / (lambda_b_ - lambda_a_) * 
+        (exp(-lambda_a_ * t) - exp(-lambda_b_ * t)); 
+    }
+
+    CompMapPtr decayed(DecaySolverPtr solver, double years) {
+      DecayHandler::setSolver(solver);
+      DecayHandler handler;
+      handler.setComp(comp_);
+      handler.decay(years);
+      return handler.comp();
+    }
+};
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(DecayHandlerTest, BatemanChain) {
+  BatemanSolver solver;
+  double t = 1.5;
+  Vector x_t = solver.solve(chain_, x_o_, t);
+  EXPECT_NEAR(a(t), x_t(1,1), 1e-12);
+  EXPECT_NEAR(b(t), x_t(2,1), 1e-12);
+  EXPECT_NEAR(1 - a(t) - b(t), x_t(3,1), 1e-12);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(DecayHandlerTest, BatemanMatchesUniformTaylor) {
+  BatemanSolver bateman;
+  UniformTaylor taylor;
+  double t = 3;
+  Vector exact = bateman.solve(chain_, x_o_, t);
+  Vector series = taylor.solve(chain_, x_o_, t);
+  for (int i = 1; i <= 3; i++) {
+    EXPECT_NEAR(exact(i,1), series(i,1), 1e-3);
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(DecayHandlerTest, BatemanLongTimes) {
+  BatemanSolver bateman;
+  UniformTaylor taylor;
+  double t = 1e5;
+  EXPECT_THROW(taylor.solve(chain_, x_o_, t), CycRangeException);
+  Vector x_t = bateman.solve(chain_, x_o_, t);
+  EXPECT_DOUBLE_EQ(0, x_t(1,1));
+  EXPECT_DOUBLE_EQ(0, x_t(2,1));
+  EXPECT_DOUBLE_EQ(1, x_t(3,1));
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(DecayHandlerTest, BatemanInvalidChains) {
+  BatemanSolver solver;
+  Matrix cycle = chain_;
+  cycle(1,3) = 1;
+  EXPECT_THROW(solver.solve(cycle, x_o_, 1), CycRangeException);
+  Matrix degenerate = chain_;
+  degenerate(2,2) = -lambda_a_;
+  EXPECT_THROW(solver.solve(degenerate, x_o_, 1), CycRangeException);
+  EXPECT_THROW(solver.solve(chain_, Vector(2,1), 1), CycRangeException);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(DecayHandlerTest, CramChain) {
+  CramSolver solver;
+  UniformTaylor taylor;
+  double times[] = {0, 0.1, 1.5, 20};
+  for (int i = 0; i < 4; i++) {
+    double t = times[i];
+    Vector x_t = solver.solve(chain_, x_o_, t);
+    EXPECT_NEAR(a(t), x_t(1,1), 1e-12);
+    EXPECT_NEAR(b(t), x_t(2,1), 1e-12);
+    EXPECT_NEAR(1 - a(t) - b(t), x_t(3,1), 1e-12);
+    Vector series = taylor.solve(chain_, x_o_, t);
+    EXPECT_NEAR(series(2,1), x_t(2,1), 1e-3);
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(DecayHandlerTest, CramStiff) {
+  // a short-lived daughter decayed for a long time
+  CramSolver solver;
+  UniformTaylor taylor;
+  lambda_b_ = 1e7;
+  chain_(2,2) = -lambda_b_;
+  chain_(3,2) = lambda_b_;
+  double t = 2;
+  EXPECT_THROW(taylor.solve(chain_, x_o_, t), CycRangeException);
+  Vector x_t = solver.solve(chain_, x_o_, t);
+  EXPECT_NEAR(a(t), x_t(1,1), 1e-12);
+  EXPECT_NEAR(b(t), x_t(2,1), 1e-12);
+  EXPECT_NEAR(1 - a(t) - b(t), x_t(3,1), 1e-12);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(DecayHandlerTest, SelectSolver) {
+  double years = 10;
+  CompMapPtr series = decayed(DecaySolverPtr(new UniformTaylor()), years);
+  CompMapPtr exact = decayed(DecaySolverPtr(new BatemanSolver()), years);
+  series->normalize();
+  exact->normalize();
+  EXPECT_EQ(series->size(), exact->size());
+  // the series solver is only accurate to its 1e-3 relative tolerance
+  for (CompMap::iterator it = exact->begin(); it != exact->end(); it++) {
+    EXPECT_NEAR(series->atomFraction(it->first), it->second, 1e-4);
+  }
+  EXPECT_NEAR(0.25, exact->atomFraction(1001), 1e-9);
+  CompMapPtr cram = decayed(DecaySolverPtr(new CramSolver()), years);
+  cram->normalize();
+  for (CompMap::iterator it = exact->begin(); it != exact->end(); it++) {
+    EXPECT_NEAR(cram->atomFraction(it->first), it->second, 1e-12);
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(DecayHandlerTest, MatrixExp) {
+  double t = 40;
+  Matrix expA = UniformTaylor::matrixExp(chain_, t);
+  Vector x_t = expA * x_o_;
+  EXPECT_NEAR(a(t), x_t(1,1), 1e-12);
+  EXPECT_NEAR(b(t), x_t(2,1), 1e-12);
+  EXPECT_NEAR(1 - a(t) - b(t), x_t(3,1), 1e-12);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(DecayHandlerTest, Propagators) {
+  double years = 100;
+  CompMapPtr exact = decayed(DecaySolverPtr(new BatemanSolver()), years);
+  CompMapPtr exact_month = decayed(DecaySolverPtr(new BatemanSolver()), 
+                                   1.0 / 12.0);
+  DecayHandler::setPropagatorInterval(1.0 / 12.0);
+  EXPECT_DOUBLE_EQ(1.0 / 12.0, DecayHandler::propagatorInterval());
+  // whole multiples of the interval are built from the solver's base step
+  CompMapPtr propagated = decayed(DecaySolverPtr(new BatemanSolver()), years);
+  exact->normalize();
+  propagated->normalize();
+  EXPECT_EQ(exact->size(), propagated->size());
+  for (CompMap::iterator it = exact->begin(); it != exact->end(); it++) {
+    EXPECT_NEAR(it->second, propagated->atomFraction(it->first), 1e-9);
+  }
+  // a second, shorter decay reuses the cached powers
+  CompMapPtr month = decayed(DecaySolverPtr(new BatemanSolver()), 1.0 / 12.0);
+  exact_month->normalize();
+  month->normalize();
+  for (CompMap::iterator it = month->begin(); it != month->end(); it++) {
+    EXPECT_NEAR(exact_month->atomFraction(it->first), it->second, 1e-9);
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(DecayHandlerTest, PropagatorsUseSolver) {
+  DecayHandler::setPropagatorInterval(1.0 / 12.0);
+  decayed(DecaySolverPtr(new UniformTaylor()), 1);
+
+  // changing the solver rebuilds the propagators with the new solver
+  boost::shared_ptr<CountingSolver> counter(new CountingSolver());
+  CompMapPtr propagated = decayed(counter, 10);
+  EXPECT_GT(counter->calls, 0);
+  // and reuses them while the solver is unchanged
+  int calls = counter->calls;
+  DecayHandler handler;
+  handler.setComp(comp_);
+  handler.decay(5);
+  EXPECT_EQ(calls, counter->calls);
+
+  DecayHandler::setPropagatorInterval(0);
+  CompMapPtr exact = decayed(DecaySolverPtr(new BatemanSolver()), 10);
+  exact->normalize();
+  propagated->normalize();
+  for (CompMap::iterator it = exact->begin(); it != exact->end(); it++) {
+    EXPECT_NEAR(it->second, propagated->atomFraction(it->first), 1e-9);
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(DecayHandlerTest, StableCompositions) {
+  CompMapPtr stable(new CompMap(ATOM));
+  (*stable)[1001] = 0.75;
+  (*stable)[2004] = 0.25;
+  stable->normalize();
+  DecayHandler handler;
+  EXPECT_TRUE(handler.isStable(stable));
+  EXPECT_FALSE(handler.isStable(comp_));
+
+  DecayHandler::setSolver(DecaySolverPtr(new BatemanSolver()));
+  handler.setComp(stable);
+  handler.decay(1000);
+  CompMapPtr decayed = handler.comp();
+  EXPECT_NE(stable, decayed);
+  EXPECT_EQ(stable->size(), decayed->size());
+  EXPECT_DOUBLE_EQ(0.75, decayed->atomFraction(1001));
+  EXPECT_DOUBLE_EQ(0.25, decayed->atomFraction(2004));
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(DecayHandlerTest, UnorderedChain) {
+  // the chain with its isotopes in reverse, so that A is upper triangular
+  Matrix reversed(3,3);
+  Vector x_o(3,1);
+  for (int i = 1; i <= 3; i++) {
+    for (int j = 1; j <= 3; j++) {
+      reversed(4-i,4-j) = chain_(i,j);
+    }
+    x_o(4-i,1) = x_o_(i,1);
+  }
+  double t = 2.5;
+  BatemanSolver bateman;
+  CramSolver cram;
+  Vector exact = bateman.solve(chain_, x_o_, t);
+  Vector bateman_t = bateman.solve(reversed, x_o, t);
+  Vector cram_t = cram.solve(reversed, x_o, t);
+  Vector cram_ordered = cram.solve(chain_, x_o_, t);
+  for (int i = 1; i <= 3; i++) {
+    EXPECT_NEAR(exact(i,1), bateman_t(4-i,1), 1e-12);
+    EXPECT_NEAR(exact(i,1), cram_t(4-i,1), 1e-12);
+    EXPECT_NEAR(exact(i,1), cram_ordered(i,1), 1e-12);
+  }
+}
@@ -80,3 +80,10 @@ TEST_F(IsoVectorTests,separation) {
 TEST_F(IsoVectorTests,decay) {
   /// \@MJG_FLAG this needs to be written... think about the best way to do it
 }
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+TEST_F(IsoVectorTests,decay_stable) {
+  CompMapPtr stable = add_to_vec.comp();
+  add_to_vec.decay(120);
+  EXPECT_EQ(stable, add_to_vec.comp());
+}
@@ -0,0 +1,112 @@
+// LMatrixTests.cpp
+#include <gtest/gtest.h>
+
+#include "LMatrix.h"
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class LMatrixTest : public ::testing::Test {
+  protected:
+    int n_;
+    LMatrix A_;
+
+    virtual void SetUp() {
+      // larger than a block, so that the blocked products are exercised
+      n_ = 100;
+      A_ = LMatrix(n_,n_);
+      for (int i = 1; i <= n_; i++) {
+        for (int j = 1; j <= n_; j++) {
+          A_(i,j) = ((i * 7 + j * 3) % 11 - 5) / 50.0L;
+        }
+      }
+    }
+
+    // the textbook product, for comparison
+    LMatrix naiveProduct(const LMatrix& A, const LMatrix& B) {
+      LMatrix C(A.numRows(),B.numCols());
+      for (int i = 1; i <= A.numRows(); i++) {
+        for (int j = 1; j <= B.numCols(); j++) {
+          for (int k = 1; k <= A.numCols(); k++) {
+            C(i,j) += A(i,k) * B(k,j);
+          }
+        }
+      }
+      return C;
+    }
+};
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(LMatrixTest, Product) {
+  LMatrix expected = naiveProduct(A_,A_);
+  LMatrix product = A_ * A_;
+  ASSERT_EQ(n_, product.numRows());
+  ASSERT_EQ(n_, product.numCols());
+  for (int i = 1; i <= n_; i++) {
+    for (int j = 1; j <= n_; j++) {
+      EXPECT_DOUBLE_EQ(expected(i,j), product(i,j));
+    }
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(LMatrixTest, NonSquareProduct) {
+  LMatrix B(3,2);
+  LMatrix x(2,1);
+  B(1,1) = 1; B(1,2) = 2;
+  B(2,1) = 3; B(2,2) = 4;
+  B(3,1) = 5; B(3,2) = 6;
+  x(1,1) = 1; x(2,1) = -1;
+  LMatrix y = B * x;
+  ASSERT_EQ(3, y.numRows());
+  ASSERT_EQ(1, y.numCols());
+  EXPECT_DOUBLE_EQ(-1, y(1,1));
+  EXPECT_DOUBLE_EQ(-1, y(2,1));
+  EXPECT_DOUBLE_EQ(-1, y(3,1));
+  // mismatched dimensions leave the matrix unchanged
+  LMatrix z = x * B;
+  EXPECT_EQ(2, z.numRows());
+  EXPECT_EQ(1, z.numCols());
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(LMatrixTest, Power) {
+  LMatrix expected = A_;
+  for (int k = 1; k < 11; k++) {
+    expected = naiveProduct(expected,A_);
+  }
+  LMatrix power = A_ ^ 11;
+  for (int i = 1; i <= n_; i++) {
+    for (int j = 1; j <= n_; j++) {
+      EXPECT_NEAR(expected(i,j), power(i,j), 1e-12);
+    }
+  }
+  LMatrix unchanged = A_ ^ 1;
+  EXPECT_DOUBLE_EQ(A_(2,3), unchanged(2,3));
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(LMatrixTest, AddRow) {
+  LMatrix v(2,1);
+  v(1,1) = 1;
+  v.addRow(std::vector<long double>(1,3));
+  ASSERT_EQ(3, v.numRows());
+  EXPECT_DOUBLE_EQ(3, v(3,1));
+  EXPECT_THROW(v(4,1), std::out_of_range);
+  EXPECT_THROW(v(1,2), std::out_of_range);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(LMatrixTest, DoubleMatrix) {
+  DMatrix B = DMatrix::identity(n_);
+  DMatrix C(n_,n_);
+  for (int i = 1; i <= n_; i++) {
+    for (int j = 1; j <= n_; j++) {
+      C(i,j) = (double)A_(i,j);
+    }
+  }
+  DMatrix product = 2.0 * (C * B);
+  for (int i = 1; i <= n_; i++) {
+    for (int j = 1; j <= n_; j++) {
+      EXPECT_DOUBLE_EQ(2 * C(i,j), product(i,j));
+    }
+  }
+}
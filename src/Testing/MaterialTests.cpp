@@ -118,6 +118,20 @@ TEST_F(MaterialTest, CheckIsoAtoms){
   ASSERT_FLOAT_EQ(test_mat_->moles(), total_atoms);
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
+TEST_F(MaterialTest, IsoQueriesKeepBasis){
+  // querying isotopes must not flip the basis of a shared composition
+  CompMapPtr shared = diff_mat_->isoVector().comp();
+  Basis orig = shared->basis();
+  double u235_mass = diff_mat_->mass(u235_);
+  double u235_moles = diff_mat_->moles(u235_);
+  EXPECT_EQ(orig, shared->basis());
+  EXPECT_FLOAT_EQ(u235_mass, diff_mat_->mass(u235_));
+  EXPECT_FLOAT_EQ(u235_moles, diff_mat_->moles(u235_));
+  EXPECT_FLOAT_EQ(test_size_, diff_mat_->mass(u235_) + 
+                  diff_mat_->mass(pb208_) + diff_mat_->mass(am241_));
+}
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
 TEST_F(MaterialTest, CheckConvertFromKg){
   EXPECT_FLOAT_EQ(1000, test_mat_->convertFromKg(1,G)); // 1000g = 1 kg
@@ -243,3 +257,63 @@ TEST_F(MaterialTest, Extract_diff_comp) {
   EXPECT_NE( orig_u235, diff_mat_->moles(u235_) );
 }
 
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
+TEST_F(MaterialTest, LazyDecay) {
+  double lambda = 3.623352E-01; // th228, in inverse years
+  CompMapPtr th228_comp = CompMapPtr(new CompMap(ATOM));
+  (*th228_comp)[th228_] = 1;
+  th228_comp->normalize();
+
+  TI->initialize(120, 1, 2010, 0, 12);
+  Material::setLazyDecay(true);
+  mat_rsrc_ptr mat = mat_rsrc_ptr(new Material(th228_comp));
+  mat->setQuantity(test_size_);
+
+  // decayMaterials() leaves it alone, and observing it decays it to the 
+  // last interval, 24 months, in one step
+  TI->initialize(120, 1, 2010, 30, 12);
+  Material::decayMaterials(TI->time());
+  double th228_frac = mat->moles(th228_) / mat->moles();
+  EXPECT_NEAR(exp(-2 * lambda), th228_frac, 1e-6);
+  EXPECT_NEAR(th228_frac, mat->moles(th228_) / mat->moles(), 1e-12);
+
+  Material::setLazyDecay(false);
+  TI->initialize();
+  Material::setDecay(0);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
+TEST_F(MaterialTest, LiveMaterials) {
+  int n_live = Material::nLiveMaterials();
+  mat_rsrc_ptr mat = mat_rsrc_ptr(new Material(test_comp_));
+  mat_rsrc_ptr other = mat_rsrc_ptr(new Material(test_comp_));
+  EXPECT_EQ(n_live + 2, Material::nLiveMaterials());
+  // absorbed materials leave as soon as they are released
+  mat->absorb(other);
+  other.reset();
+  EXPECT_EQ(n_live + 1, Material::nLiveMaterials());
+  rsrc_ptr copy = mat->clone();
+  EXPECT_EQ(n_live + 2, Material::nLiveMaterials());
+  mat.reset();
+  copy.reset();
+  EXPECT_EQ(n_live, Material::nLiveMaterials());
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -    
+TEST_F(MaterialTest, DecayLiveMaterials) {
+  double lambda = 3.623352E-01; // th228, in inverse years
+  CompMapPtr th228_comp = CompMapPtr(new CompMap(ATOM));
+  (*th228_comp)[th228_] = 1;
+  th228_comp->normalize();
+
+  TI->initialize(120, 1, 2010, 0, 12);
+  mat_rsrc_ptr mat = mat_rsrc_ptr(new Material(th228_comp));
+  mat->setQuantity(test_size_);
+  TI->initialize(120, 1, 2010, 12, 12);
+  Material::decayMaterials(TI->time());
+  EXPECT_NEAR(exp(-lambda), mat->moles(th228_) / mat->moles(), 1e-6);
+
+  TI->initialize();
+  Material::setDecay(0);
+}
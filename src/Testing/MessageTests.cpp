@@ -5,6 +5,9 @@
 #include "Resource.h"
 #include "GenericResource.h"
 #include "CycException.h"
+#include "InstModel.h"
+#include "RegionModel.h"
+#include "StubCommModel.h"
 
 #include <string>
 #include <vector>
@@ -347,6 +350,17 @@ TEST_F(MessagePublicInterfaceTest, Cloning) {
   EXPECT_DOUBLE_EQ(resource2->quantity(), quantity2);
 }
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(MessagePublicInterfaceTest, CloningWithoutTrans) {
+  msg_ptr bare(new Message(comm1));
+  EXPECT_FALSE(bare->hasTrans());
+  EXPECT_FALSE(bare->hasReceiver());
+  msg_ptr copy;
+  ASSERT_NO_THROW(copy = bare->clone());
+  EXPECT_FALSE(copy->hasTrans());
+  EXPECT_TRUE(msg1->hasTrans());
+  EXPECT_TRUE(msg1->hasReceiver());
+}
 
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 //- - - - - - - - - Getters and Setters - - - - - - - - - - - - - - - - - -
@@ -365,3 +379,118 @@ TEST_F(MessagePublicInterfaceTest, GetSetResource) {
   ASSERT_DOUBLE_EQ(msg1->trans().resource()->quantity(), quantity2);
 }
 
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//- - - - - - - - - - - - -Batch Sending- - - - - - - - - - - - - - - - - -
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class BatchRegion : public RegionModel { };
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class BatchInst : public InstModel {
+ public:
+  BatchInst() : n_batches_(0) { }
+
+  virtual void receiveMessages(MessageBatch msgs) {
+    n_batches_++;
+    InstModel::receiveMessages(msgs);
+  }
+
+  int n_batches_;
+};
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class BatchFac : public StubCommModel {
+ public:
+  BatchFac() : n_received_(0) { }
+
+  virtual void receiveMessage(msg_ptr msg) {
+    n_received_++;
+  }
+
+  int n_received_;
+};
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class BatchMarket : public Communicator {
+ public:
+  BatchMarket() : n_batches_(0) { }
+
+  vector<msg_ptr> received_;
+  int n_batches_;
+
+ private:
+  virtual void receiveMessage(msg_ptr msg) {
+    received_.push_back(msg);
+  }
+
+  virtual void receiveMessages(MessageBatch msgs) {
+    n_batches_++;
+    received_.insert(received_.end(), msgs.begin(), msgs.end());
+  }
+};
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(MessageBatchTest, SendBatch) {
+  BatchRegion* reg = new BatchRegion();
+  BatchInst* inst = new BatchInst();
+  BatchFac* fac = new BatchFac();
+  inst->enterSimulation(reg);
+  fac->enterSimulation(inst);
+  BatchMarket market;
+
+  MessageBatch batch;
+  for (int i = 0; i < 3; i++) {
+    batch.push_back(msg_ptr(new Message(fac, &market)));
+  }
+  Message::sendBatch(batch);
+
+  EXPECT_EQ(1, inst->n_batches_);
+  EXPECT_EQ(1, market.n_batches_);
+  ASSERT_EQ(3, market.received_.size());
+  EXPECT_EQ(batch[0], market.received_[0]);
+  EXPECT_EQ(batch[2], market.received_[2]);
+
+  // the messages find their own way back down
+  msg_ptr msg = market.received_[1];
+  msg->setDir(DOWN_MSG);
+  EXPECT_NO_THROW(msg->sendOn());
+  EXPECT_EQ(1, fac->n_received_);
+
+  delete fac;
+  delete inst;
+  delete reg;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(MessageBatchTest, RouteFollowsTree) {
+  BatchRegion* reg = new BatchRegion();
+  BatchInst* first = new BatchInst();
+  BatchInst* second = new BatchInst();
+  BatchFac* fac = new BatchFac();
+  first->enterSimulation(reg);
+  second->enterSimulation(reg);
+  fac->enterSimulation(first);
+  BatchMarket market;
+
+  EXPECT_EQ(NULL, reg->tryParent());
+  EXPECT_EQ(first, fac->tryParent());
+
+  msg_ptr msg(new Message(fac, &market));
+  msg->sendOn();
+  EXPECT_EQ(1, market.received_.size());
+
+  // a new parent is picked up by the next message
+  first->removeChild(fac);
+  fac->enterSimulation(second);
+  Message::sendBatch(MessageBatch(1, msg_ptr(new Message(fac, &market))));
+  EXPECT_EQ(0, first->n_batches_);
+  EXPECT_EQ(1, second->n_batches_);
+  EXPECT_EQ(2, market.received_.size());
+
+  delete fac;
+  delete first;
+  delete second;
+  delete reg;
+}
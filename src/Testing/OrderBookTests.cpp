@@ -0,0 +1,153 @@
+// OrderBookTests.cpp
+#include <gtest/gtest.h>
+
+#include <ctime>
+
+#include "OrderBook.h"
+#include "GenericResource.h"
+#include "StubCommModel.h"
+#include "Transaction.h"
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class Trader : public StubCommModel {
+ public:
+  virtual void receiveMessage(msg_ptr msg) {}
+};
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class OrderBookTests : public ::testing::Test {
+ protected:
+  Trader* supplier_;
+  Trader* requester_;
+  OrderBook book_;
+
+  virtual void SetUp() {
+    supplier_ = new Trader();
+    requester_ = new Trader();
+  }
+
+  virtual void TearDown() {
+    delete supplier_;
+    delete requester_;
+  }
+
+  msg_ptr order(TransType type, double qty, double price, 
+                double minfrac = 0) {
+    Trader* creator = (type == OFFER) ? supplier_ : requester_;
+    rsrc_ptr rsrc = gen_rsrc_ptr(new GenericResource("kg","bananas",qty));
+    Transaction trans(creator,type,rsrc,price,minfrac);
+    msg_ptr msg(new Message(creator,creator,trans));
+    book_.add(msg);
+    return msg;
+  }
+};
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(OrderBookTests,PriceOrder) {
+  msg_ptr dear = order(OFFER,1,5);
+  msg_ptr cheap = order(OFFER,1,1);
+  msg_ptr low = order(REQUEST,1,2);
+  msg_ptr high = order(REQUEST,1,10);
+  std::vector<MatchedOrders> matches = book_.match();
+  // the highest request takes the cheapest offer, the rest can't trade
+  ASSERT_EQ(1,matches.size());
+  EXPECT_EQ(cheap,matches[0].first);
+  EXPECT_EQ(high,matches[0].second);
+  EXPECT_EQ(requester_,matches[0].first->trans().requester());
+  EXPECT_EQ(supplier_,matches[0].second->trans().supplier());
+  EXPECT_EQ(1,book_.nOffers());
+  EXPECT_EQ(1,book_.nRequests());
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(OrderBookTests,PartialFills) {
+  msg_ptr offer = order(OFFER,5,1);
+  msg_ptr first = order(REQUEST,2,1);
+  msg_ptr second = order(REQUEST,4,1);
+  std::vector<MatchedOrders> matches = book_.match();
+  ASSERT_EQ(2,matches.size());
+  EXPECT_NE(offer,matches[0].first);
+  EXPECT_DOUBLE_EQ(2,matches[0].first->trans().resource()->quantity());
+  EXPECT_EQ(first,matches[0].second);
+  // the offer's last part is the offer itself
+  EXPECT_EQ(offer,matches[1].first);
+  EXPECT_DOUBLE_EQ(3,matches[1].first->trans().resource()->quantity());
+  EXPECT_NE(second,matches[1].second);
+  EXPECT_DOUBLE_EQ(3,matches[1].second->trans().resource()->quantity());
+  // what is left of the second request stays in the book
+  EXPECT_EQ(0,book_.nOffers());
+  EXPECT_EQ(1,book_.nRequests());
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(OrderBookTests,MinFrac) {
+  msg_ptr small = order(OFFER,1,1);
+  msg_ptr large = order(OFFER,4,2);
+  msg_ptr request = order(REQUEST,4,2,1);
+  std::vector<MatchedOrders> matches = book_.match();
+  // the request won't take part of its quantity from the cheaper offer
+  ASSERT_EQ(1,matches.size());
+  EXPECT_EQ(large,matches[0].first);
+  EXPECT_EQ(request,matches[0].second);
+  EXPECT_EQ(1,book_.nOffers());
+  EXPECT_EQ(0,book_.nRequests());
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(OrderBookTests,MinFracPassedOver) {
+  msg_ptr whole = order(OFFER,4,1,1);
+  msg_ptr dear = order(OFFER,1,2);
+  msg_ptr high = order(REQUEST,1,10);
+  msg_ptr large = order(REQUEST,4,5);
+  std::vector<MatchedOrders> matches = book_.match();
+  // the high request is too small for the cheap offer, but still
+  // trades with the dearer one
+  ASSERT_EQ(2,matches.size());
+  EXPECT_EQ(dear,matches[0].first);
+  EXPECT_EQ(high,matches[0].second);
+  EXPECT_EQ(whole,matches[1].first);
+  EXPECT_EQ(large,matches[1].second);
+  EXPECT_EQ(0,book_.nOffers());
+  EXPECT_EQ(0,book_.nRequests());
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(OrderBookTests,MinFracRemainderDropped) {
+  msg_ptr cheap = order(OFFER,4,1,0.5);
+  msg_ptr dear = order(OFFER,1,2);
+  msg_ptr high = order(REQUEST,3,10);
+  msg_ptr low = order(REQUEST,1,5);
+  std::vector<MatchedOrders> matches = book_.match();
+  // what is left of the cheap offer is below its minimum, which does
+  // not keep the low request from the dearer offer
+  ASSERT_EQ(2,matches.size());
+  EXPECT_NE(cheap,matches[0].first);
+  EXPECT_DOUBLE_EQ(3,matches[0].first->trans().resource()->quantity());
+  EXPECT_EQ(high,matches[0].second);
+  EXPECT_EQ(dear,matches[1].first);
+  EXPECT_EQ(low,matches[1].second);
+  EXPECT_EQ(0,book_.nOffers());
+  EXPECT_EQ(0,book_.nRequests());
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(OrderBookTests,Scaling) {
+  // each request takes one offer, so used up offers must not be 
+  // looked at again by the requests after them
+  double seconds[2];
+  int sizes[] = {10000, 40000};
+  for (int k = 0; k < 2; k++) {
+    for (int i = 0; i < sizes[k]; i++) {
+      order(OFFER,1,1);
+      order(REQUEST,1,1);
+    }
+    std::clock_t start = std::clock();
+    std::vector<MatchedOrders> matches = book_.match();
+    seconds[k] = double(std::clock() - start) / CLOCKS_PER_SEC;
+    EXPECT_EQ(sizes[k],matches.size());
+    EXPECT_EQ(0,book_.nOffers());
+    EXPECT_EQ(0,book_.nRequests());
+  }
+  // four times the orders, well under sixteen times the time
+  EXPECT_LT(seconds[1],8 * seconds[0] + 0.05);
+}
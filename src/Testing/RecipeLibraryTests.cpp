@@ -0,0 +1,155 @@
+// RecipeLibraryTests.cpp 
+#include <gtest/gtest.h>
+
+#include "RecipeLibraryTests.h"
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+TEST_F(RecipeLibraryTests,decay_cache_hits) {
+  int hits = RL->decayCacheHits();
+  int misses = RL->decayCacheMisses();
+  CompMapPtr child = decayedRecipe(t1_);
+  EXPECT_EQ(misses + 1,RL->decayCacheMisses());
+  EXPECT_TRUE(RL->childRecorded(recipe_,t1_));
+  EXPECT_EQ(child,decayedRecipe(t1_));
+  EXPECT_EQ(hits + 1,RL->decayCacheHits());
+  EXPECT_EQ(recipe_,child->root_comp());
+  EXPECT_DOUBLE_EQ(t1_,child->root_decay_time());
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+TEST_F(RecipeLibraryTests,decay_cache_eviction) {
+  CompMapPtr first = decayedRecipe(t1_);
+  int id = first->ID();
+  CompMapPtr second = decayedRecipe(t2_);
+  // only the most recently used child survives a zero capacity
+  int evictions = RL->decayCacheEvictions();
+  RL->setDecayCacheCapacity(0);
+  EXPECT_EQ(1,RL->decayCacheSize());
+  EXPECT_LT(evictions,RL->decayCacheEvictions());
+  EXPECT_FALSE(RL->childRecorded(recipe_,t1_));
+  EXPECT_TRUE(RL->childRecorded(recipe_,t2_));
+  // a recomputed child keeps its recorded id
+  CompMapPtr recomputed = decayedRecipe(t1_);
+  EXPECT_NE(first,recomputed);
+  EXPECT_EQ(id,recomputed->ID());
+  EXPECT_TRUE(*first == *recomputed);
+  EXPECT_FALSE(RL->childRecorded(recipe_,t2_));
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+TEST_F(RecipeLibraryTests,prewarm_decay_cache) {
+  int n_times = 3;
+  int interval = 5;
+  RL->prewarmDecayCache(n_times * interval + 2,interval,4);
+  for (int i = 1; i <= n_times; i++) {
+    EXPECT_TRUE(RL->childRecorded(recipe_,i * interval));
+  }
+  EXPECT_FALSE(RL->childRecorded(recipe_,(n_times + 1) * interval));
+
+  // the simulation only looks the children up
+  int hits = RL->decayCacheHits();
+  int misses = RL->decayCacheMisses();
+  CompMapPtr child = decayedRecipe(2 * interval);
+  EXPECT_EQ(hits + 1,RL->decayCacheHits());
+  EXPECT_EQ(misses,RL->decayCacheMisses());
+  EXPECT_TRUE(child->recorded());
+
+  DecayHandler handler;
+  handler.setComp(recipe_);
+  handler.decay(2 * interval / 12.0);
+  CompMapPtr expected = handler.comp();
+  expected->normalize();
+  for (CompMap::iterator it = expected->begin(); it != expected->end(); it++) {
+    EXPECT_DOUBLE_EQ(it->second,child->atomFraction(it->first));
+  }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+TEST_F(RecipeLibraryTests,compact_output_dedup) {
+  RL->setCompactOutput(true);
+  CompMapPtr first = CompMapPtr(new CompMap(ATOM));
+  (*first)[1001] = 2;
+  (*first)[8016] = 1;
+  RL->recordRecipe(first);
+  CompMapPtr same = CompMapPtr(new CompMap(ATOM));
+  (*same)[1001] = 4;
+  (*same)[8016] = 2;
+  RL->recordRecipe(same);
+  EXPECT_TRUE(same->recorded());
+  EXPECT_EQ(first->ID(),same->ID());
+  CompMapPtr other = CompMapPtr(new CompMap(ATOM));
+  (*other)[1001] = 1;
+  (*other)[8016] = 1;
+  RL->recordRecipe(other);
+  EXPECT_NE(first->ID(),other->ID());
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+TEST_F(RecipeLibraryTests,compact_output_bounded) {
+  RL->setCompactOutput(true);
+  long capacity = RL->fingerprintCapacity();
+  RL->setFingerprintCapacity(0);
+  EXPECT_EQ(0,RL->fingerprintMemory());
+  RL->setFingerprintCapacity(capacity);
+  double oxygen[] = {1, 2, 3, 1, 3};
+  std::vector<CompMapPtr> comps;
+  for (int i = 0; i < 5; i++) {
+    CompMapPtr comp = CompMapPtr(new CompMap(ATOM));
+    (*comp)[1001] = 1;
+    (*comp)[8016] = oxygen[i];
+    comps.push_back(comp);
+  }
+  for (int i = 0; i < 3; i++) {
+    RL->recordRecipe(comps.at(i));
+  }
+  // room for the two most recently used compositions
+  long memory = RL->fingerprintMemory();
+  RL->setFingerprintCapacity(memory - 1);
+  EXPECT_LT(RL->fingerprintMemory(),memory);
+  RL->recordRecipe(comps.at(4));
+  EXPECT_EQ(comps.at(2)->ID(),comps.at(4)->ID());
+  // the forgotten composition is written again
+  RL->recordRecipe(comps.at(3));
+  EXPECT_TRUE(comps.at(3)->recorded());
+  EXPECT_NE(comps.at(0)->ID(),comps.at(3)->ID());
+  EXPECT_LE(RL->fingerprintMemory(),memory - 1);
+  RL->setFingerprintCapacity(capacity);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+TEST_F(RecipeLibraryTests,compact_output_decay) {
+  RL->setCompactOutput(true);
+  CompMapPtr child = decayedRecipe(t1_ + t2_);
+  EXPECT_TRUE(child->recorded());
+  EXPECT_EQ(recipe_,child->parent());
+  EXPECT_NE(recipe_->ID(),child->ID());
+  EXPECT_TRUE(child->normalized());
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+TEST_F(RecipeLibraryTests,composition_blobs) {
+  Fingerprint isos;
+  isos.push_back(std::make_pair(94239,0.25));
+  isos.push_back(std::make_pair(92235,1e-300));
+  isos.push_back(std::make_pair(1001,0.0));
+  for (int compress = 0; compress <= 1; compress++) {
+    std::string bytes = RL->encodeComposition(isos,compress);
+    if (!compress) {
+      EXPECT_EQ(4 + 12 * isos.size(),bytes.size());
+    }
+    Fingerprint decoded = RL->decodeComposition(bytes,compress);
+    ASSERT_EQ(isos.size(),decoded.size());
+    EXPECT_EQ(1001,decoded[0].first);
+    EXPECT_EQ(92235,decoded[1].first);
+    EXPECT_EQ(94239,decoded[2].first);
+    EXPECT_EQ(1e-300,decoded[1].second);
+    EXPECT_EQ(0.25,decoded[2].second);
+  }
+  Fingerprint empty;
+  for (int compress = 0; compress <= 1; compress++) {
+    std::string bytes = RL->encodeComposition(empty,compress);
+    EXPECT_TRUE(RL->decodeComposition(bytes,compress).empty());
+  }
+  EXPECT_THROW(RL->decodeComposition("abc",false),CycParseException);
+  EXPECT_THROW(RL->decodeComposition("abc",true),CycParseException);
+}
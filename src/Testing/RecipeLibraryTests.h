@@ -0,0 +1,37 @@
+#include <gtest/gtest.h>
+
+#include "RecipeLibrary.h"
+#include "IsoVector.h"
+#include "DecayHandler.h"
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class RecipeLibraryTests : public ::testing::Test {
+ protected:
+  CompMapPtr recipe_;
+  long capacity_;
+  double t1_, t2_;
+
+ public:
+  virtual void SetUp() { 
+    capacity_ = RL->decayCacheCapacity();
+    t1_ = 12;
+    t2_ = 24;
+    recipe_ = CompMapPtr(new CompMap(MASS));
+    (*recipe_)[92235] = 1;
+    (*recipe_)[92238] = 1;
+    recipe_->normalize();
+    RL->recordRecipe("recipe_library_test",recipe_);
+    recipe_ = RL->Recipe("recipe_library_test");
+  }
+
+  virtual void TearDown() {
+    RL->setDecayCacheCapacity(capacity_);
+    RL->setCompactOutput(false);
+  }
+
+  CompMapPtr decayedRecipe(double time) {
+    IsoVector vec = IsoVector(recipe_);
+    vec.decay(time);
+    return vec.comp();
+  }
+};
@@ -126,3 +126,15 @@ TEST_F(RegionModelClassTests, TockIter) {
   EXPECT_EQ(child5_->tockCount_, 2);
 }
 
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+TEST_F(RegionModelClassTests, ExitsAppended) {
+  int agent_rows = Model::agent_table->nRows();
+  int exit_rows = Model::agent_exit_table->nRows();
+  delete child1_;
+  delete child2_;
+  EXPECT_EQ(agent_rows, Model::agent_table->nRows());
+  ASSERT_EQ(exit_rows + 2, Model::agent_exit_table->nRows());
+  std::string cmd = Model::agent_exit_table->row_command(exit_rows)->str();
+  EXPECT_EQ(0, cmd.find("INSERT INTO AgentExits"));
+}
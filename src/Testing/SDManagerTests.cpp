@@ -3,6 +3,7 @@
 #include "SDManagerTests.h"
 
 #include "CycException.h"
+#include "Timer.h"
 
 using namespace std;
 using namespace SupplyDemand;
@@ -48,3 +49,15 @@ TEST_F(SDManagerTests,demand) {
     EXPECT_EQ(manager.demand(helper->commodity,i),demand->value(i));
   }
 }
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(SDManagerTests,tabulateddemand) {
+  TI->initialize(12, 1, 2010, 5, 0);
+  EXPECT_NO_THROW(manager.registerCommodity(helper->commodity,demand));
+  EXPECT_NO_THROW(manager.tabulateDemand());
+  EXPECT_NE(manager.demandFunction(helper->commodity),demand);
+  for (int i = 0; i < 25; i++) {
+    EXPECT_DOUBLE_EQ(manager.demand(helper->commodity,i),demand->value(i));
+  }
+  TI->initialize();
+}
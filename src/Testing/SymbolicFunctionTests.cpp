@@ -177,3 +177,37 @@ TEST_F(SymbolicFunctionTests,piecewisefunc)
     }
   //output.close();
 }
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(SymbolicFunctionTests,piecewisevalues) 
+{
+  FunctionPtr f = getPiecewiseFunction();
+
+  // ascending arguments, then the same arguments reversed
+  int n = 40;
+  vector<double> x(2*n), y(2*n);
+  for (int i = 0; i < n; i++)
+    {
+      x.at(i) = -1 + i * 0.4;
+      x.at(2*n-1-i) = x.at(i);
+    }
+  f->values(&x[0],&y[0],2*n);
+  for (int i = 0; i < 2*n; i++)
+    {
+      EXPECT_DOUBLE_EQ(f->value(x.at(i)),y.at(i));
+    }
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(SymbolicFunctionTests,tabulatedfunc) 
+{
+  FunctionPtr f = getPiecewiseFunction();
+  FunctionPtr table(new TabulatedFunction(f,2,10));
+
+  // in the table, between its entries, and outside of it
+  for (int i = 0; i < 30; i++)
+    {
+      double x = i * 0.5;
+      EXPECT_DOUBLE_EQ(f->value(x),table->value(x));
+    }
+}
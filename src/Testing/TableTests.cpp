@@ -133,3 +133,15 @@ TEST_F(TableTest, FlushRows) {
   EXPECT_NO_THROW( test_table->flush() );
   EXPECT_EQ( test_table->nRows(), 0 );
 }
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+TEST_F(TableTest, BlobLiteral) {
+  blob b;
+  b.bytes = std::string("\x00\x1f\xff",3);
+  std::stringstream literal;
+  literal << data(b);
+  EXPECT_EQ( literal.str(), "X'001FFF'" );
+  blob read;
+  literal >> read;
+  EXPECT_EQ( read.bytes, b.bytes );
+}
@@ -0,0 +1,165 @@
+// TimerTests.cpp
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "Timer.h"
+#include "MarketModel.h"
+#include "GenericResource.h"
+#include "StubCommModel.h"
+#include "Transaction.h"
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// a timer of its own, so that the tests can send resolves directly
+class ResolveTimer : public Timer {
+ public:
+  void resolve() { sendResolve(); }
+};
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// a market that records when it matches and resolves
+class RecordingMarket : public MarketModel {
+ public:
+  RecordingMarket(std::vector<int>& resolved, bool fail = false)
+    : resolved_(resolved), fail_(fail), matches(0), matched_first(false) {}
+
+  virtual void receiveMessage(msg_ptr msg) {}
+
+  virtual void match() {
+    matches++;
+    if (fail_) {
+      throw std::runtime_error("no match");
+    }
+  }
+
+  virtual void resolve() {
+    matched_first = (matches > 0);
+    resolved_.push_back(ID());
+  }
+
+  int matches;
+  bool matched_first;
+
+ private:
+  std::vector<int>& resolved_;
+  bool fail_;
+};
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class TimerTests : public ::testing::Test {
+ protected:
+  std::vector<RecordingMarket*> markets_;
+  std::vector<int> resolved_;
+
+  virtual void SetUp() {
+    for (int i = 0; i < 5; i++) {
+      markets_.push_back(new RecordingMarket(resolved_, i == 2));
+    }
+  }
+
+  virtual void TearDown() {
+    for (int i = 0; i < markets_.size(); i++) {
+      delete markets_.at(i);
+    }
+  }
+
+  void resolve(int n_threads) {
+    ResolveTimer timer;
+    timer.setResolveThreads(n_threads);
+    for (int i = 0; i < markets_.size(); i++) {
+      timer.registerResolveListener(markets_.at(i));
+    }
+    timer.resolve();
+  }
+
+  void expectAllMatched() {
+    std::vector<int> order;
+    for (int i = 0; i < markets_.size(); i++) {
+      EXPECT_EQ(1, markets_.at(i)->matches);
+      if (i != 2) {
+        EXPECT_TRUE(markets_.at(i)->matched_first);
+        order.push_back(markets_.at(i)->ID());
+      }
+    }
+    // the market whose match failed is not resolved
+    EXPECT_EQ(order, resolved_);
+  }
+};
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(TimerTests, ResolveOneThread) {
+  resolve(1);
+  expectAllMatched();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(TimerTests, ResolveThreads) {
+  resolve(3);
+  expectAllMatched();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(TimerTests, ResolveMoreThreadsThanMarkets) {
+  resolve(8);
+  expectAllMatched();
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class BookTrader : public StubCommModel {
+ public:
+  virtual void receiveMessage(msg_ptr msg) {}
+};
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// a market that clears by price with the order book
+class BookMarket : public MarketModel {
+ public:
+  BookMarket() { useOrderBook(); }
+  virtual void receiveMessage(msg_ptr msg) { messages_.insert(msg); }
+  virtual void resolve() { applyOrderBook(); }
+  std::deque<msg_ptr>& orders() { return orders_; }
+};
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// the transaction IDs given by the book markets, from the first
+std::vector<int> bookTransIDs(int n_threads) {
+  BookTrader trader;
+  std::vector<BookMarket*> markets;
+  ResolveTimer timer;
+  timer.setResolveThreads(n_threads);
+  for (int i = 0; i < 3; i++) {
+    BookMarket* market = new BookMarket();
+    TransType types[] = {OFFER, REQUEST, REQUEST};
+    for (int j = 0; j < 3; j++) {
+      double qty = (j == 0) ? 2 : 1;
+      rsrc_ptr rsrc = gen_rsrc_ptr(new GenericResource("kg","apples",qty));
+      Transaction trans(&trader,types[j],rsrc,1);
+      market->receiveMessage(msg_ptr(new Message(&trader,&trader,trans)));
+    }
+    timer.registerResolveListener(market);
+    markets.push_back(market);
+  }
+  timer.resolve();
+
+  std::vector<int> ids;
+  int first = markets.at(0)->orders().front()->trans().transID();
+  for (int i = 0; i < markets.size(); i++) {
+    // the offer is split between the requests
+    std::deque<msg_ptr>& orders = markets.at(i)->orders();
+    EXPECT_EQ(4,orders.size());
+    for (int j = 0; j < orders.size(); j++) {
+      EXPECT_DOUBLE_EQ(1,orders.at(j)->trans().resource()->quantity());
+      ids.push_back(orders.at(j)->trans().transID() - first);
+    }
+    delete markets.at(i);
+  }
+  return ids;
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(TimerBookTests, BookMarketsMatchOnThreads) {
+  std::vector<int> serial = bookTransIDs(1);
+  ASSERT_EQ(12,serial.size());
+  EXPECT_EQ(serial,bookTransIDs(3));
+}
@@ -7,6 +7,8 @@
 #include <iostream>
 #include "Model.h"
 #include "DynamicModule.h"
+#include "Timer.h"
+#include "RecipeLibrary.h"
 
 using namespace std;
 
@@ -76,6 +78,35 @@ std::string XMLFileLoaderTests::recipeSequence() {
           "</simulation>";
 }
 
+std::string XMLFileLoaderTests::topRecipeSequence(std::string prefix) {
+  return  "<simulation>"
+          " <recipe>"
+          "  <name>" + prefix + "_uox</name>"
+          "  <basis>mass</basis>"
+          "  <isotope>"
+          "   <id>92235</id>"
+          "   <comp>0.05</comp>"
+          "  </isotope>"
+          "  <isotope>"
+          "   <id>92238</id>"
+          "   <comp>0.95</comp>"
+          "  </isotope>"
+          " </recipe>"
+          " <recipe>"
+          "  <name>" + prefix + "_water</name>"
+          "  <basis>atom</basis>"
+          "  <isotope>"
+          "   <id>1001</id>"
+          "   <comp>2</comp>"
+          "  </isotope>"
+          "  <isotope>"
+          "   <id>8016</id>"
+          "   <comp>1</comp>"
+          "  </isotope>"
+          " </recipe>"
+          "</simulation>";
+}
+
 std::string XMLFileLoaderTests::moduleSequence() {
   return  "<simulation>"
           "  <!-- markets -->"
@@ -177,3 +208,49 @@ TEST_F(XMLFileLoaderTests,schema) {
   EXPECT_NO_THROW(xmlFile->applySchema(schema););
   delete xmlFile;
 }
+
+TEST_F(XMLFileLoaderTests,streamed) {
+  EXPECT_THROW(XMLFileLoader file("blah",false,true), CycIOException);
+
+  // the streamed control parameters match the parsed ones
+  xmlFile = new XMLFileLoader(controlFile,false);
+  xmlFile->load_control_parameters();
+  delete xmlFile;
+  int dur = TI->simDur();
+  boost::gregorian::date start = TI->startDate();
+  EXPECT_EQ(1200,dur);
+  EXPECT_EQ(boost::gregorian::date(2000,1,1),start);
+  TI->initialize();
+  xmlFile = new XMLFileLoader(controlFile,false,true);
+  EXPECT_NO_THROW(xmlFile->load_control_parameters());
+  EXPECT_EQ(dur,TI->simDur());
+  EXPECT_EQ(start,TI->startDate());
+  stringstream schema(controlSchema());
+  EXPECT_THROW(xmlFile->applySchema(schema),CycLoadXMLException);
+  delete xmlFile;
+  TI->initialize();
+
+  // and so are the recipes
+  string prefixes[] = {"parsed", "streamed"};
+  for (int i = 0; i < 2; i++) {
+    string file = prefixes[i] + "_recipes.xml";
+    createTestInputFile(file,topRecipeSequence(prefixes[i]));
+    xmlFile = new XMLFileLoader(file,false,i == 1);
+    EXPECT_NO_THROW(xmlFile->load_recipes());
+    delete xmlFile;
+    unlink(file.c_str());
+  }
+  string names[] = {"_uox", "_water"};
+  for (int i = 0; i < 2; i++) {
+    ASSERT_TRUE(RL->recipeRecorded(prefixes[0] + names[i]));
+    ASSERT_TRUE(RL->recipeRecorded(prefixes[1] + names[i]));
+    CompMapPtr parsed = RL->Recipe(prefixes[0] + names[i]);
+    CompMapPtr streamed = RL->Recipe(prefixes[1] + names[i]);
+    EXPECT_EQ(2,streamed->size());
+    EXPECT_EQ(parsed->size(),streamed->size());
+    for (CompMap::iterator it = parsed->begin(); it != parsed->end(); it++) {
+      EXPECT_DOUBLE_EQ(parsed->massFraction(it->first),
+                       streamed->massFraction(it->first));
+    }
+  }
+}
@@ -13,7 +13,7 @@
 //- - - - - - - - 
 class XMLFileLoaderTests : public ::testing::Test {
 
- private:
+ protected:
 
   void createTestInputFile(std::string fname, std::string contents) {
     std::ofstream outFile(fname.c_str());
@@ -33,6 +33,7 @@ class XMLFileLoaderTests : public ::testing::Test {
   std::string falseSequence();
   std::string controlSequence();
   std::string recipeSequence();
+  std::string topRecipeSequence(std::string prefix);
   std::string moduleSequence();
   std::string controlSchema();
 
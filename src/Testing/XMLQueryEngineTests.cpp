@@ -6,6 +6,14 @@
 
 using namespace std;
 
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+// an engine whose current node can be moved by the tests
+class MovableQueryEngine : public XMLQueryEngine {
+ public:
+  MovableQueryEngine(XMLParser& parser) : XMLQueryEngine(parser) {};
+  void moveTo(xmlpp::Node* node) { setCurrentNode(node); }
+};
+
 //- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
 std::string XMLQueryEngineTest::unknowncontent() {
   stringstream ss("");
@@ -107,3 +115,32 @@ TEST_F(XMLQueryEngineTest,low_level_queries) {
   QueryEngine* qe2 = qe->queryElement(unknown_node_);
   EXPECT_EQ(qe2->getElementContent(content_node_),content_);
 }
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(XMLQueryEngineTest,repeated_queries) {  
+  loadParser();
+  XMLQueryEngine engine(*parser_);
+  QueryEngine* qe = engine.queryElement(inner_node_);
+  EXPECT_EQ(engine.queryElement(inner_node_),qe);
+  EXPECT_NE(engine.queryElement(content_node_,1),engine.queryElement(content_node_,0));
+  std::string path = inner_node_ + "/" + unknown_node_ + "/" + content_node_;
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(engine.nElementsMatchingQuery(path),1);
+    EXPECT_EQ(engine.getElementContent(path),content_);
+  }
+  EXPECT_EQ(engine.nElementsMatchingQuery("*"),ninner_nodes_);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(XMLQueryEngineTest,set_current_node) {  
+  loadParser();
+  MovableQueryEngine engine(*parser_);
+  EXPECT_EQ(engine.queryElement("*")->nElements(),0);
+  xmlpp::Node* root = parser_->document()->get_root_node();
+  xmlpp::Node* inner = root->find(inner_node_).at(0);
+  engine.moveTo(inner);
+  EXPECT_EQ(engine.nElements(),1);
+  QueryEngine* qe = engine.queryElement("*");
+  EXPECT_EQ(qe->getElementName(),content_node_);
+  EXPECT_EQ(qe->getElementContent(content_node_),content_);
+}